@@ -14,6 +14,9 @@ void print_help() {
     printf("Comenzi disponibile:\n");
     printf("  --clients        - Afișează informații despre clienții conectați\n");
     printf("  --queue-status   - Afișează starea cozii de procesare\n");
+    printf("  --cache-stats    - Afișează statisticile cache-ului de rezultate\n");
+    printf("  --save-model     - Salvează acum modelul Bayes în fișierul serverului (--model)\n");
+    printf("  --learner-stats  - Afișează starea antrenării în fundal a modelului\n");
 }
 
 int main(int argc, char *argv[]) {
@@ -21,13 +24,19 @@ int main(int argc, char *argv[]) {
         print_help();
         return 1;
     }
-
+    
     AdminCommandType command_type;
     
     if (strcmp(argv[1], "--clients") == 0) {
         command_type = ADMIN_GET_CLIENTS;
     } else if (strcmp(argv[1], "--queue-status") == 0) {
         command_type = ADMIN_GET_QUEUE_STATUS;
+    } else if (strcmp(argv[1], "--cache-stats") == 0) {
+        command_type = ADMIN_GET_CACHE_STATS;
+    } else if (strcmp(argv[1], "--save-model") == 0) {
+        command_type = ADMIN_SAVE_MODEL;
+    } else if (strcmp(argv[1], "--learner-stats") == 0) {
+        command_type = ADMIN_GET_LEARNER_STATS;
     } else {
         printf("Comandă necunoscută: %s\n", argv[1]);
         print_help();
@@ -98,6 +107,42 @@ int main(int argc, char *argv[]) {
                        response.queue_size, 
                        response.queue_capacity);
                 break;
+                
+            case ADMIN_GET_CACHE_STATS: {
+                CacheStats* cache = &response.cache;
+                if (cache->capacity == 0) {
+                    printf("Cache-ul de rezultate este dezactivat\n");
+                    break;
+                }
+                
+                unsigned long long lookups = cache->hits + cache->misses;
+                printf("Cache-ul de rezultate:\n");
+                printf("Intrări: %llu (%llu / %llu bytes)\n", (unsigned long long)cache->entries,
+                       (unsigned long long)cache->bytes, (unsigned long long)cache->capacity);
+                printf("Găsite: %llu, negăsite: %llu (rată de reușită %.1f%%)\n",
+                       (unsigned long long)cache->hits, (unsigned long long)cache->misses,
+                       lookups ? 100.0 * cache->hits / lookups : 0.0);
+                printf("Invalidate după schimbarea modelului: %llu, eliminate (LRU): %llu\n",
+                       (unsigned long long)cache->invalidations, (unsigned long long)cache->evictions);
+                break;
+            }
+                
+            case ADMIN_SAVE_MODEL:
+                printf("Model salvat: %llu cuvinte, %llu documente, %llu bytes în %.1f ms\n",
+                       (unsigned long long)response.model.vocabulary, (unsigned long long)response.model.documents,
+                       (unsigned long long)response.model.bytes, response.model.seconds * 1000.0);
+                break;
+                
+            case ADMIN_GET_LEARNER_STATS: {
+                LearnerStats* learner = &response.learner;
+                printf("Antrenarea în fundal:\n");
+                printf("Documente în așteptare: %llu (cel mai vechi de %.3f s)\n",
+                       (unsigned long long)learner->pending, learner->lag_seconds);
+                printf("Aplicate: %llu în %llu versiuni ale modelului (%.1f/s), renunțate: %llu\n",
+                       (unsigned long long)learner->applied, (unsigned long long)learner->batches,
+                       learner->updates_per_second, (unsigned long long)learner->dropped);
+                break;
+            }
         }
     } else {
         printf("Eroare: %s\n", response.error_message);
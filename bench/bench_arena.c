@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "../common/nlp.h"
+
+// Benchmark analyze_text: memoria temporara din malloc/free (fiecare token
+// separat) fata de o arena per thread resetata dupa fiecare cerere. Ruleaza
+// cu 1 ... MAX_THREADS thread-uri simultan, ca in pool-ul de procesare al
+// serverului. (Rezumatul nu e inclus: scorarea propozitiilor domina timpul.)
+
+#define TEXT_SIZE 8192
+#define REQUESTS_PER_THREAD 1000
+#define MAX_THREADS 8
+#define ARENA_BLOCK_SIZE (256 * 1024)
+#define RUNS 3
+
+static unsigned int rng_state = 12345;
+
+static unsigned int next_random(void) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return rng_state >> 8;
+}
+
+// cuvinte dintr-un vocabular mic, grupate in propozitii
+static char* generate_text(size_t size) {
+    char* text = malloc(size + 1);
+    if (!text) return NULL;
+    
+    size_t pos = 0;
+    int words_in_sentence = 0;
+    while (pos + 12 < size) {
+        unsigned int word = next_random() % 2000;
+        int length = 4 + word % 7;
+        for (int i = 0; i < length; i++) {
+            text[pos++] = 'a' + (word * 31 + i * 7) % 26;
+        }
+        if (++words_in_sentence == 12) {
+            text[pos++] = '.';
+            words_in_sentence = 0;
+        }
+        text[pos++] = ' ';
+    }
+    while (pos < size) {
+        text[pos++] = ' ';
+    }
+    text[size] = '\0';
+    return text;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static const char* text;
+static int use_arena;
+
+static void* worker(void* arg) {
+    (void)arg;
+    Arena* arena = use_arena ? arena_create(ARENA_BLOCK_SIZE) : NULL;
+    
+    for (int i = 0; i < REQUESTS_PER_THREAD; i++) {
+        TextAnalysis* analysis = use_arena ? analyze_text_arena(text, arena) : analyze_text(text);
+        if (!analysis) {
+            fprintf(stderr, "analyze_text a esuat\n");
+            exit(1);
+        }
+    
+        if (use_arena) {
+            arena_reset(arena);
+        } else {
+            free_text_analysis(analysis);
+        }
+    }
+    
+    arena_destroy(arena);
+    return NULL;
+}
+
+static double run(int threads, int arena) {
+    pthread_t tids[MAX_THREADS];
+    use_arena = arena;
+    
+    double start = now_seconds();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&tids[i], NULL, worker, NULL);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    double elapsed = now_seconds() - start;
+    
+    return threads * REQUESTS_PER_THREAD / elapsed;
+}
+
+int main(void) {
+    char* generated = generate_text(TEXT_SIZE);
+    if (!generated) {
+        perror("Eroare la alocarea memoriei");
+        return 1;
+    }
+    text = generated;
+    
+    printf("analyze_text, %d bytes, %d cereri/thread\n",
+           TEXT_SIZE, REQUESTS_PER_THREAD);
+    printf("%-10s %-18s %-18s %-8s\n", "Thread-uri", "malloc (cereri/s)", "arena (cereri/s)", "Raport");
+    
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        // cea mai buna din RUNS rulari, alternand variantele
+        double with_malloc = 0.0, with_arena = 0.0;
+        for (int r = 0; r < RUNS; r++) {
+            double rate = run(threads, 0);
+            if (rate > with_malloc) with_malloc = rate;
+            rate = run(threads, 1);
+            if (rate > with_arena) with_arena = rate;
+        }
+        printf("%-10d %-18.0f %-18.0f %-8.2f\n", threads, with_malloc, with_arena,
+               with_arena / with_malloc);
+    }
+    
+    free(generated);
+    return 0;
+}
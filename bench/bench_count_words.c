@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pcre.h>
+#include "../common/tokenizer.h"
+#include "../common/word_count.h"
+
+// count_words: numararea cu PCRE (\b[a-zA-Z]+\b, cate o potrivire pe rand)
+// fata de variantele kernelului din word_count.c. Intai verifica pe texte
+// aleatoare ca toate dau exact rezultatul PCRE (texte fara litere romanesti)
+// si al lui next_token (texte cu diacritice), apoi masoara debitul pe un
+// text de 64 KB.
+
+#define TEXT_SIZE 65536
+#define CHECK_TEXTS 20000
+#define CHECK_MAX_LENGTH 300
+#define MIN_SECONDS 0.3
+
+static unsigned int rng_state = 12345;
+
+static unsigned int next_random(void) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return rng_state >> 8;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static pcre* word_re;
+static pcre_extra* word_extra;
+
+static size_t count_pcre(const char* text, size_t length) {
+    int ovector[30];
+    size_t count = 0;
+    int start = 0;
+    while (pcre_exec(word_re, word_extra, text, (int)length, start, 0, ovector, 30) >= 0) {
+        count++;
+        start = ovector[1];
+    }
+    return count;
+}
+
+static size_t count_tokenizer(const char* text, size_t length) {
+    size_t count = 0, pos = 0, start;
+    while (next_token(text, length, &pos, &start, 0) == TOKEN_WORD) {
+        count++;
+    }
+    return count;
+}
+
+// bytes alesi ca sa loveasca toate cazurile: granite intre litere, cifre si
+// '_', bytes >= 0x80, punctuatie; fara '\0' (textele sunt siruri C).
+// Fara diacritice, bytes >= 0x80 sunt doar 0x80..0xBF, care nu pot incepe
+// o litera romaneasca; cu diacritice apar si literele (mari, mici, cu
+// sedila), alte caractere de 2 bytes si bytes de inceput izolati.
+static size_t random_text(char* text, size_t length, int diacritics) {
+    static const char alphabet[] = "aZm_09 .,!?-\t\n";
+    static const char* pairs[] = { "\xc4\x83", "\xc4\x82", "\xc3\xa2", "\xc3\x82", "\xc3\xae", "\xc3\x8e",
+                                   "\xc8\x99", "\xc8\x98", "\xc8\x9b", "\xc8\x9a", "\xc5\x9f", "\xc5\x9e",
+                                   "\xc5\xa3", "\xc5\xa2", "\xc3\xa9", "\xc4\x87", "\xc8", "\xc3" };
+    size_t i = 0;
+    while (i < length) {
+        unsigned int r = next_random();
+        if (diacritics && r % 6 == 0) {
+            const char* pair = pairs[r / 6 % (sizeof(pairs) / sizeof(pairs[0]))];
+            for (size_t k = 0; pair[k] && i < length; k++) {
+                text[i++] = pair[k];
+            }
+        } else if (r % 8 == 0) {
+            text[i++] = (char)(0x80 + r / 8 % 64);
+        } else {
+            text[i++] = alphabet[r / 8 % (sizeof(alphabet) - 1)];
+        }
+    }
+    text[length] = '\0';
+    return length;
+}
+
+// text "obisnuit" in romana: cuvinte, spatii, diacritice si cateva numere
+static void generate_text(char* text, size_t size) {
+    static const char* words[] = { "echipa", "a", "castigat", "meciul", "de", "fotbal",
+                                   "\xc8\x99i", "guvernul", "\xc3\xaen", "2024", "AI", "date" };
+    size_t pos = 0;
+    while (pos < size) {
+        const char* word = words[next_random() % (sizeof(words) / sizeof(words[0]))];
+        for (size_t i = 0; word[i] && pos < size; i++) {
+            text[pos++] = word[i];
+        }
+        if (pos < size) {
+            text[pos++] = next_random() % 10 == 0 ? '.' : ' ';
+        }
+    }
+    text[size] = '\0';
+}
+
+static const char* kernel_names[] = { "scalar", "sse2", "avx2" };
+#define KERNEL_COUNT (sizeof(kernel_names) / sizeof(kernel_names[0]))
+
+// jumatate din texte fata de PCRE, jumatate (cu diacritice) fata de next_token
+static int verify(void) {
+    char text[CHECK_MAX_LENGTH + 1];
+    
+    for (int t = 0; t < CHECK_TEXTS; t++) {
+        int diacritics = t % 2;
+        size_t length = random_text(text, next_random() % (CHECK_MAX_LENGTH + 1), diacritics);
+    
+        size_t expected = diacritics ? count_tokenizer(text, length) : count_pcre(text, length);
+        if (!diacritics && count_tokenizer(text, length) != expected) {
+            fprintf(stderr, "Diferenta la next_token: %zu in loc de %zu pentru \"%s\"\n",
+                    count_tokenizer(text, length), expected, text);
+            return -1;
+        }
+        for (size_t k = 0; k < KERNEL_COUNT; k++) {
+            WordCountKernel kernel = word_count_kernel(kernel_names[k]);
+            if (kernel && kernel(text, length) != expected) {
+                fprintf(stderr, "Diferenta la %s: %zu in loc de %zu pentru \"%s\"\n",
+                        kernel_names[k], kernel(text, length), expected, text);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static double measure(WordCountKernel kernel, const char* text, size_t length, size_t* count) {
+    int iterations = 0;
+    double start = now_seconds(), elapsed;
+    do {
+        *count = kernel(text, length);
+        iterations++;
+        elapsed = now_seconds() - start;
+    } while (elapsed < MIN_SECONDS);
+    
+    return (double)length * iterations / elapsed / 1e9;
+}
+
+int main(void) {
+    const char* error;
+    int erroffset;
+    word_re = pcre_compile("\\b[a-zA-Z]+\\b", 0, &error, &erroffset, NULL);
+    if (!word_re) {
+        fprintf(stderr, "PCRE compile error: %s\n", error);
+        return 1;
+    }
+    word_extra = pcre_study(word_re, 0, &error);
+    
+    if (verify() < 0) {
+        return 1;
+    }
+    printf("Verificare: %d texte aleatoare, toate variantele identice cu PCRE si next_token\n", CHECK_TEXTS);
+    
+    char* text = malloc(TEXT_SIZE + 1);
+    if (!text) {
+        perror("Eroare la alocarea memoriei");
+        return 1;
+    }
+    generate_text(text, TEXT_SIZE);
+    
+    printf("Text de %d bytes\n", TEXT_SIZE);
+    printf("%-9s %-10s %-10s\n", "Varianta", "Cuvinte", "GB/s");
+    
+    size_t count;
+    double rate = measure(count_pcre, text, TEXT_SIZE, &count);
+    printf("%-9s %-10zu %-10.3f\n", "pcre", count, rate);
+    
+    rate = measure(count_tokenizer, text, TEXT_SIZE, &count);
+    printf("%-9s %-10zu %-10.3f\n", "tokenizer", count, rate);
+    
+    for (size_t k = 0; k < KERNEL_COUNT; k++) {
+        WordCountKernel kernel = word_count_kernel(kernel_names[k]);
+        if (!kernel) {
+            printf("%-9s %-10s\n", kernel_names[k], "indisponibil");
+            continue;
+        }
+        rate = measure(kernel, text, TEXT_SIZE, &count);
+        printf("%-9s %-10zu %-10.3f\n", kernel_names[k], count, rate);
+    }
+    
+    free(text);
+    return 0;
+}
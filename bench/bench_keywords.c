@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../common/keywords.h"
+#include "../common/tokenizer.h"
+
+// Benchmark determine_topic pe un text de 64 KB, cu tot mai multe cuvinte
+// cheie: vechea cale (fiecare token comparat cu fiecare cuvant cheie) si
+// automatul Aho-Corasick (o singura trecere, indiferent de numarul lor).
+// Cuvintele cheie sunt impartite in DOMAINS domenii, iar textul foloseste
+// cuvinte cheie in proportie de 1 din 8.
+
+#define TEXT_SIZE 65536
+#define DOMAINS 3
+#define MAX_KEYWORDS 5000
+#define MIN_SECONDS 0.2
+
+static unsigned int rng_state = 12345;
+
+static unsigned int next_random(void) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return rng_state >> 8;
+}
+
+// cuvinte distincte: primele 3 litere codifica indexul
+static char keywords[MAX_KEYWORDS][16];
+static int keyword_count;
+static KeywordSet* keyword_set;
+
+static void generate_keywords(void) {
+    for (int i = 0; i < MAX_KEYWORDS; i++) {
+        char* word = keywords[i];
+        word[0] = 'a' + i / (26 * 26);
+        word[1] = 'a' + i / 26 % 26;
+        word[2] = 'a' + i % 26;
+        int length = 3 + 2 + next_random() % 6;
+        for (int j = 3; j < length; j++) {
+            word[j] = 'a' + next_random() % 26;
+        }
+        word[length] = '\0';
+    }
+}
+
+// size bytes de propozitii; un cuvant din 8 e un cuvant cheie
+static char* generate_text(size_t size) {
+    char* text = malloc(size + 1);
+    if (!text) return NULL;
+    
+    size_t pos = 0;
+    int words_in_sentence = 0;
+    while (pos + 24 < size) {
+        if (next_random() % 8 == 0) {
+            const char* word = keywords[next_random() % keyword_count];
+            size_t length = strlen(word);
+            memcpy(text + pos, word, length);
+            pos += length;
+        } else {
+            int length = 3 + next_random() % 8;
+            for (int i = 0; i < length; i++) {
+                text[pos++] = 'a' + next_random() % 26;
+            }
+        }
+        if (++words_in_sentence == 12) {
+            text[pos++] = '.';
+            words_in_sentence = 0;
+        }
+        text[pos++] = ' ';
+    }
+    while (pos < size) {
+        text[pos++] = ' ';
+    }
+    text[size] = '\0';
+    return text;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// vechea cale: token normalizat, apoi strcmp cu toate cuvintele cheie
+static int scan_linear(const char* text, size_t length, int* scores) {
+    char word[256];
+    size_t pos = 0, start;
+    while (next_token(text, length, &pos, &start, 0) == TOKEN_WORD) {
+        if (pos - start >= sizeof(word)) {
+            continue;
+        }
+        memcpy(word, text + start, pos - start);
+        int word_length = fold_word(word, (int)(pos - start), 0);
+        word[word_length] = '\0';
+        for (int k = 0; k < keyword_count; k++) {
+            if (strcmp(word, keywords[k]) == 0) {
+                scores[k % DOMAINS]++;
+            }
+        }
+    }
+    return 0;
+}
+
+static int scan_automaton(const char* text, size_t length, int* scores) {
+    char word[256];
+    size_t pos = 0, start;
+    int state = keyword_set_start(keyword_set);
+    TokenKind kind;
+    while ((kind = next_token(text, length, &pos, &start, 1)) != TOKEN_NONE) {
+        if (kind == TOKEN_TERMINATOR || pos - start >= sizeof(word)) {
+            state = keyword_set_start(keyword_set);
+            continue;
+        }
+        memcpy(word, text + start, pos - start);
+        int word_length = fold_word(word, (int)(pos - start), 0);
+        state = keyword_set_feed(keyword_set, state, word, word_length, scores);
+    }
+    return 0;
+}
+
+// ns/byte pentru scan, repetat cel putin MIN_SECONDS
+static double measure(int (*scan)(const char*, size_t, int*), const char* text, size_t size, int* scores) {
+    int iterations = 0;
+    double start = now_seconds();
+    double elapsed;
+    do {
+        memset(scores, 0, DOMAINS * sizeof(int));
+        scan(text, size, scores);
+        iterations++;
+        elapsed = now_seconds() - start;
+    } while (elapsed < MIN_SECONDS);
+    
+    return elapsed / iterations * 1e9 / size;
+}
+
+int main(void) {
+    static const int counts[] = { 30, 300, 1000, MAX_KEYWORDS };
+    
+    generate_keywords();
+    
+    printf("ns/byte, text de %d bytes\n", TEXT_SIZE);
+    printf("%-10s %-12s %-12s %-10s\n", "Cuvinte", "liniar", "automat", "Potriviri");
+    
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        keyword_count = counts[c];
+        keyword_set = keyword_set_create(0);
+        if (!keyword_set) {
+            perror("Eroare la alocarea memoriei");
+            return 1;
+        }
+        for (int d = 0; d < DOMAINS; d++) {
+            char name[16];
+            snprintf(name, sizeof(name), "domeniu%d", d);
+            if (keyword_set_domain(keyword_set, name) != d) {
+                perror("Eroare la alocarea memoriei");
+                return 1;
+            }
+        }
+        for (int k = 0; k < keyword_count; k++) {
+            if (keyword_set_add(keyword_set, k % DOMAINS, keywords[k]) < 0) {
+                perror("Eroare la alocarea memoriei");
+                return 1;
+            }
+        }
+        char* text = generate_text(TEXT_SIZE);
+        if (!text || keyword_set_build(keyword_set) < 0) {
+            perror("Eroare la alocarea memoriei");
+            return 1;
+        }
+    
+        int linear_scores[DOMAINS], automaton_scores[DOMAINS];
+        double linear_rate = measure(scan_linear, text, TEXT_SIZE, linear_scores);
+        double automaton_rate = measure(scan_automaton, text, TEXT_SIZE, automaton_scores);
+        if (memcmp(linear_scores, automaton_scores, sizeof(linear_scores)) != 0) {
+            fprintf(stderr, "Scoruri diferite pentru %d cuvinte cheie\n", keyword_count);
+            return 1;
+        }
+    
+        printf("%-10d %-12.2f %-12.2f %-10d\n", keyword_count, linear_rate, automaton_rate,
+               linear_scores[0] + linear_scores[1] + linear_scores[2]);
+        free(text);
+        keyword_set_destroy(keyword_set);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "../common/protocol.h"
+
+// Latenta cererilor scurte (cerere -> raspuns pe aceeasi conexiune) fata
+// de un server pornit local: cererea scrisa camp cu camp (cate un write,
+// ca inainte) sau ca un singur cadru (send_request), cu si fara TCP_NODELAY.
+// Ruleaza cu 1 ... MAX_CONNECTIONS conexiuni simultane.
+
+#define SERVER_IP "127.0.0.1"
+#define PORT 12345
+#define REQUESTS_PER_CONNECTION 200
+#define WARMUP_REQUESTS 20
+#define MAX_CONNECTIONS 8
+
+static const char* short_text = "Echipa a castigat meciul de fotbal.";
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// formatul de fir al lui send_request, dar cu cate un write pe camp
+static int send_request_fields(int sockfd, Request* req) {
+    int type = req->type | req->flags;
+    size_t text_len = strlen(req->text) + 1;
+    
+    if (write(sockfd, &type, sizeof(type)) < 0 ||
+        write(sockfd, &text_len, sizeof(text_len)) < 0 ||
+        write(sockfd, req->text, text_len) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+typedef struct {
+    int coalesced;
+    int nodelay;
+    double* latencies;      // REQUESTS_PER_CONNECTION valori, in secunde
+    int failed;
+} Worker;
+
+static void* run_connection(void* arg) {
+    Worker* worker = (Worker*)arg;
+    
+    int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in server_addr;
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_port = htons(PORT);
+    inet_pton(AF_INET, SERVER_IP, &server_addr.sin_addr);
+    
+    if (sockfd < 0 || connect(sockfd, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
+        worker->failed = 1;
+        if (sockfd >= 0) close(sockfd);
+        return NULL;
+    }
+    if (worker->nodelay) {
+        enable_tcp_nodelay(sockfd);
+    }
+    
+    Request* request = (Request*)malloc(sizeof(Request));
+    if (!request) {
+        worker->failed = 1;
+        close(sockfd);
+        return NULL;
+    }
+    request->version = 1;                   // formatul comparat cu scrierea pe campuri
+    request->type = REQUEST_COUNT_WORDS;
+    request->flags = 0;
+    request->request_id = 0;
+    strcpy(request->text, short_text);
+    
+    for (int i = 0; i < WARMUP_REQUESTS + REQUESTS_PER_CONNECTION; i++) {
+        double start = now_seconds();
+    
+        int sent = worker->coalesced ? send_request(sockfd, request) : send_request_fields(sockfd, request);
+        Response response;
+        response.version = request->version;
+        response.flags = 0;
+        if (sent < 0 || receive_response(sockfd, &response) < 0 || response.status != STATUS_OK) {
+            worker->failed = 1;
+            break;
+        }
+        free(response.topic);
+        free(response.summary);
+    
+        if (i >= WARMUP_REQUESTS) {
+            worker->latencies[i - WARMUP_REQUESTS] = now_seconds() - start;
+        }
+    }
+    
+    free(request);
+    close(sockfd);
+    return NULL;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static int run(int connections, int coalesced, int nodelay) {
+    static double latencies[MAX_CONNECTIONS * REQUESTS_PER_CONNECTION];
+    Worker workers[MAX_CONNECTIONS];
+    pthread_t tids[MAX_CONNECTIONS];
+    
+    double start = now_seconds();
+    for (int i = 0; i < connections; i++) {
+        workers[i].coalesced = coalesced;
+        workers[i].nodelay = nodelay;
+        workers[i].latencies = latencies + i * REQUESTS_PER_CONNECTION;
+        workers[i].failed = 0;
+        pthread_create(&tids[i], NULL, run_connection, &workers[i]);
+    }
+    for (int i = 0; i < connections; i++) {
+        pthread_join(tids[i], NULL);
+        if (workers[i].failed) {
+            return -1;
+        }
+    }
+    double elapsed = now_seconds() - start;
+    
+    int count = connections * REQUESTS_PER_CONNECTION;
+    double total = 0.0;
+    for (int i = 0; i < count; i++) {
+        total += latencies[i];
+    }
+    qsort(latencies, count, sizeof(double), compare_double);
+    
+    printf("%-6d %-12s %-9s %-12.1f %-12.1f %-12.1f %-10.0f\n", connections,
+           coalesced ? "un cadru" : "pe campuri", nodelay ? "da" : "nu",
+           total / count * 1e6, latencies[count / 2] * 1e6, latencies[count * 99 / 100] * 1e6,
+           count / elapsed);
+    return 0;
+}
+
+int main(void) {
+    printf("COUNT_WORDS de %zu bytes, %d cereri/conexiune, server pe %s:%d\n",
+           strlen(short_text) + 1, REQUESTS_PER_CONNECTION, SERVER_IP, PORT);
+    printf("%-6s %-12s %-9s %-12s %-12s %-12s %-10s\n", "Conex.", "Cerere", "NODELAY",
+           "medie (us)", "p50 (us)", "p99 (us)", "cereri/s");
+    
+    for (int connections = 1; connections <= MAX_CONNECTIONS; connections *= 8) {
+        for (int coalesced = 0; coalesced <= 1; coalesced++) {
+            for (int nodelay = 0; nodelay <= 1; nodelay++) {
+                if (run(connections, coalesced, nodelay) < 0) {
+                    fprintf(stderr, "Eroare de comunicare (serverul ruleaza pe portul %d?)\n", PORT);
+                    return 1;
+                }
+            }
+        }
+    }
+    
+    return 0;
+}
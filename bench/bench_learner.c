@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "../common/nlp.h"
+#include "../server/learner.h"
+
+// Benchmark pasul de clasificare al unei cereri REQUEST_DETERMINE_TOPIC,
+// cu 1 ... MAX_THREADS thread-uri de procesare: antrenarea inline sub
+// lock-ul de scriere (calea veche) fata de learner-ul din fundal. Se
+// masoara cererile pe secunda si latenta p99 a pasului; documentele sunt
+// tokenizate dinainte, ca in server (analiza se face o singura data).
+
+#define DOCUMENTS 512
+#define WORDS_PER_DOCUMENT 400
+#define REQUESTS_PER_THREAD 4000
+#define MAX_THREADS 8
+#define LEARNER_QUEUE 4096
+
+static const char* domains[] = { "Sport", "Politică", "Tehnologie" };
+#define DOMAIN_COUNT (sizeof(domains) / sizeof(domains[0]))
+
+static unsigned int rng_state = 12345;
+
+static unsigned int next_random(void) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return rng_state >> 8;
+}
+
+// cuvinte dintr-un vocabular de 20000, un sfert specifice domeniului
+static char* generate_document(int domain) {
+    char* text = malloc(WORDS_PER_DOCUMENT * 12 + 1);
+    if (!text) return NULL;
+    
+    size_t pos = 0;
+    for (int w = 0; w < WORDS_PER_DOCUMENT; w++) {
+        unsigned int word = next_random() % 20000;
+        if (w % 4 == 0) {
+            word = word / DOMAIN_COUNT * DOMAIN_COUNT + domain;
+        }
+        int length = 4 + word % 6;
+        for (int i = 0; i < length; i++) {
+            text[pos++] = 'a' + (word * 31 + i * 7 + word / 26) % 26;
+        }
+        text[pos++] = w % 15 == 14 ? '.' : ' ';
+    }
+    text[pos] = '\0';
+    return text;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static TokenizationResult* documents[DOCUMENTS];
+
+// calea veche
+static BayesClassifier* inline_classifier;
+static pthread_rwlock_t inline_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+static Learner* learner;
+static int use_learner;
+
+typedef struct {
+    int id;
+    double* latencies;
+} WorkerArgs;
+
+static void* worker(void* arg) {
+    WorkerArgs* args = (WorkerArgs*)arg;
+    
+    for (int i = 0; i < REQUESTS_PER_THREAD; i++) {
+        int index = (args->id * 7919 + i) % DOCUMENTS;
+        TokenizationResult* tokens = documents[index];
+        // modelul se antreneaza cu eticheta documentului, nu cu ce a ghicit
+        const char* domain = domains[index % DOMAIN_COUNT];
+        double start = now_seconds();
+        char* topic;
+    
+        if (use_learner) {
+            int copy;
+            BayesClassifier* classifier = learner_acquire(learner, &copy);
+            topic = classify_tokens_bayes(classifier, tokens);
+            learner_release(learner, copy);
+            learner_submit(learner, tokens, domain);
+        } else {
+            pthread_rwlock_rdlock(&inline_lock);
+            topic = classify_tokens_bayes(inline_classifier, tokens);
+            pthread_rwlock_unlock(&inline_lock);
+            pthread_rwlock_wrlock(&inline_lock);
+            train_bayes_classifier_tokens(inline_classifier, tokens, domain);
+            pthread_rwlock_unlock(&inline_lock);
+        }
+    
+        args->latencies[i] = now_seconds() - start;
+        free(topic);
+    }
+    return NULL;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// cereri/s; *p99 in microsecunde, *dropped documente renuntate de learner
+static double run(int threads, int with_learner, double* p99, unsigned long long* dropped) {
+    pthread_t tids[MAX_THREADS];
+    WorkerArgs args[MAX_THREADS];
+    double* latencies = malloc((size_t)threads * REQUESTS_PER_THREAD * sizeof(double));
+    if (!latencies) {
+        perror("Eroare la alocarea memoriei");
+        exit(1);
+    }
+    
+    use_learner = with_learner;
+    inline_classifier = init_bayes_classifier();
+    learner = learner_create(init_bayes_classifier(), init_bayes_classifier(), LEARNER_QUEUE);
+    if (!inline_classifier || !learner) {
+        perror("Eroare la alocarea memoriei");
+        exit(1);
+    }
+    
+    double start = now_seconds();
+    for (int i = 0; i < threads; i++) {
+        args[i].id = i;
+        args[i].latencies = latencies + (size_t)i * REQUESTS_PER_THREAD;
+        pthread_create(&tids[i], NULL, worker, &args[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    double elapsed = now_seconds() - start;
+    
+    size_t total = (size_t)threads * REQUESTS_PER_THREAD;
+    qsort(latencies, total, sizeof(double), compare_double);
+    *p99 = latencies[total * 99 / 100] * 1e6;
+    
+    LearnerStats stats;
+    learner_stats(learner, &stats);
+    *dropped = stats.dropped;
+    
+    free(latencies);
+    free_bayes_classifier(inline_classifier);
+    learner_destroy(learner);
+    return total / elapsed;
+}
+
+int main(void) {
+    for (int d = 0; d < DOCUMENTS; d++) {
+        char* text = generate_document(d % DOMAIN_COUNT);
+        documents[d] = text ? tokenize_text(text) : NULL;
+        if (!documents[d]) {
+            perror("Eroare la alocarea memoriei");
+            return 1;
+        }
+        free(text);
+    }
+    
+    printf("clasificare + antrenare, documente de %d cuvinte, %d cereri/thread\n",
+           WORDS_PER_DOCUMENT, REQUESTS_PER_THREAD);
+    printf("%-10s %-16s %-14s %-16s %-14s %-10s\n", "Thread-uri", "inline (cer/s)", "inline p99 us",
+           "learner (cer/s)", "learner p99 us", "Renunțate");
+    
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        double inline_p99, learner_p99;
+        unsigned long long unused, dropped;
+        double inline_rate = run(threads, 0, &inline_p99, &unused);
+        double learner_rate = run(threads, 1, &learner_p99, &dropped);
+        printf("%-10d %-16.0f %-14.1f %-16.0f %-14.1f %-10llu\n", threads, inline_rate, inline_p99,
+               learner_rate, learner_p99, dropped);
+    }
+    
+    for (int d = 0; d < DOCUMENTS; d++) {
+        free_tokenization_result(documents[d]);
+    }
+    return 0;
+}
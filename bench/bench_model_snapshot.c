@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../common/model_snapshot.h"
+
+// Benchmark pornirea serverului cu un model mare: reantrenarea din
+// documente (ce ar trebui facut fara snapshot) fata de salvarea si
+// incarcarea snapshot-ului. La final se verifica faptul ca modelul
+// incarcat clasifica identic cu cel antrenat si ca modelul chiar raspunde:
+// documentele sintetice nu contin cuvinte cheie, deci fara Bayes nu ar
+// avea alt raspuns decat "Necunoscut". Un bit schimbat in antet (in
+// numarul total de documente) trebuie sa opreasca incarcarea.
+
+#define DOCUMENTS 20000
+#define WORDS_PER_DOCUMENT 200
+#define VOCABULARY_SIZE 200000
+#define CHECK_DOCUMENTS 200
+// procentul minim de documente noi clasificate in domeniul lor
+#define MIN_ACCURACY 90
+
+static const char* domains[] = { "Sport", "Politică", "Tehnologie" };
+#define DOMAIN_COUNT (sizeof(domains) / sizeof(domains[0]))
+
+static unsigned int rng_state = 12345;
+
+static unsigned int next_random(void) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return rng_state >> 8;
+}
+
+// cuvantul i din vocabularul sintetic: litere care codifica indexul
+static int synthetic_word(char* out, unsigned int index) {
+    int length = 0;
+    do {
+        out[length++] = 'a' + index % 26;
+        index /= 26;
+    } while (index > 0);
+    out[length++] = 'x';
+    out[length++] = 'z';
+    return length;
+}
+
+// documentul d al domeniului dat: cuvinte comune plus un sfert specifice
+// domeniului, ca sa existe ceva de invatat
+static char* generate_document(int domain) {
+    char* text = malloc(WORDS_PER_DOCUMENT * 12 + 1);
+    if (!text) return NULL;
+    
+    size_t pos = 0;
+    for (int w = 0; w < WORDS_PER_DOCUMENT; w++) {
+        unsigned int index = next_random() % VOCABULARY_SIZE;
+        if (w % 4 == 0) {
+            index = index / DOMAIN_COUNT * DOMAIN_COUNT + domain;
+        }
+        pos += synthetic_word(text + pos, index);
+        text[pos++] = w % 15 == 14 ? '.' : ' ';
+    }
+    text[pos] = '\0';
+    return text;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+    char path[] = "/tmp/bench_model_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        return 1;
+    }
+    close(fd);
+    
+    char** documents = malloc(DOCUMENTS * sizeof(char*));
+    if (!documents) {
+        perror("Eroare la alocarea memoriei");
+        return 1;
+    }
+    for (int d = 0; d < DOCUMENTS; d++) {
+        documents[d] = generate_document(d % DOMAIN_COUNT);
+        if (!documents[d]) {
+            perror("Eroare la alocarea memoriei");
+            return 1;
+        }
+    }
+    
+    double start = now_seconds();
+    BayesClassifier* trained = init_bayes_classifier();
+    if (!trained) {
+        perror("Eroare la alocarea memoriei");
+        return 1;
+    }
+    for (int d = 0; d < DOCUMENTS; d++) {
+        train_bayes_classifier(trained, documents[d], domains[d % DOMAIN_COUNT]);
+    }
+    double train_seconds = now_seconds() - start;
+    
+    start = now_seconds();
+    long long bytes = save_model_snapshot(trained, 0, path);
+    double save_seconds = now_seconds() - start;
+    if (bytes < 0) {
+        perror(path);
+        return 1;
+    }
+    
+    start = now_seconds();
+    BayesClassifier* loaded = load_model_snapshot(path, 0);
+    double load_seconds = now_seconds() - start;
+    if (!loaded) {
+        return 1;
+    }
+    
+    printf("Model: %d cuvinte, %d documente, snapshot de %lld bytes\n",
+           trained->vocabulary.count, trained->total_documents, bytes);
+    printf("%-14s %10.1f ms\n", "reantrenare", train_seconds * 1000.0);
+    printf("%-14s %10.1f ms\n", "salvare", save_seconds * 1000.0);
+    printf("%-14s %10.1f ms\n", "incarcare", load_seconds * 1000.0);
+    
+    // acelasi rezultat pe documente noi, inclusiv dupa antrenare online
+    int correct = 0;
+    for (int d = 0; d < CHECK_DOCUMENTS; d++) {
+        char* text = generate_document(d % DOMAIN_COUNT);
+        char* expected = classify_text_bayes(trained, text);
+        char* actual = classify_text_bayes(loaded, text);
+        if (strcmp(expected, actual) != 0) {
+            fprintf(stderr, "Clasificare diferita dupa incarcare: %s / %s\n", expected, actual);
+            return 1;
+        }
+        if (strcmp(expected, "Necunoscut") == 0) {
+            fprintf(stderr, "Modelul antrenat nu a clasificat documentul %d\n", d);
+            return 1;
+        }
+        correct += strcmp(expected, domains[d % DOMAIN_COUNT]) == 0;
+        train_bayes_classifier(trained, text, domains[d % DOMAIN_COUNT]);
+        train_bayes_classifier(loaded, text, domains[d % DOMAIN_COUNT]);
+        free(expected);
+        free(actual);
+        free(text);
+    }
+    
+    printf("%-14s %10d%%\n", "acuratete", correct * 100 / CHECK_DOCUMENTS);
+    if (correct * 100 < MIN_ACCURACY * CHECK_DOCUMENTS) {
+        fprintf(stderr, "Acuratete sub %d%%\n", MIN_ACCURACY);
+        return 1;
+    }
+    
+    // total_documents e la offset-ul 44 din antet
+    FILE* file = fopen(path, "r+b");
+    int byte = file && fseek(file, 44, SEEK_SET) == 0 ? fgetc(file) : EOF;
+    if (byte == EOF || fseek(file, 44, SEEK_SET) != 0 || fputc(byte ^ 1, file) == EOF ||
+        fclose(file) != 0) {
+        perror(path);
+        return 1;
+    }
+    BayesClassifier* corrupt = load_model_snapshot(path, 0);
+    if (corrupt) {
+        fprintf(stderr, "Snapshot cu antetul modificat incarcat fara eroare\n");
+        return 1;
+    }
+    
+    for (int d = 0; d < DOCUMENTS; d++) {
+        free(documents[d]);
+    }
+    free(documents);
+    free_bayes_classifier(trained);
+    free_bayes_classifier(loaded);
+    unlink(path);
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include "../server/request_queue.h"
+
+// Microbenchmark: coada mutex/condvar (implementarea veche din server.c)
+// comparata cu inelul fara lock-uri din request_queue.c, la 1..64 producatori
+// si CONSUMERS consumatori.
+
+#define CAPACITY 128
+#define CONSUMERS 4
+#define TOTAL_ITEMS 400000
+#define MAX_PRODUCERS 64
+
+// --- coada veche: mutex + doua variabile de conditie ---
+
+typedef struct {
+    ProcessingRequest queue[CAPACITY];
+    int front;
+    int rear;
+    int count;
+    pthread_mutex_t mutex;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+} MutexQueue;
+
+static MutexQueue mutex_queue;
+
+static void mutex_init_queue(void) {
+    mutex_queue.front = 0;
+    mutex_queue.rear = -1;
+    mutex_queue.count = 0;
+    pthread_mutex_init(&mutex_queue.mutex, NULL);
+    pthread_cond_init(&mutex_queue.not_empty, NULL);
+    pthread_cond_init(&mutex_queue.not_full, NULL);
+}
+
+static void mutex_enqueue(ProcessingRequest request) {
+    pthread_mutex_lock(&mutex_queue.mutex);
+    while (mutex_queue.count >= CAPACITY) {
+        pthread_cond_wait(&mutex_queue.not_full, &mutex_queue.mutex);
+    }
+    mutex_queue.rear = (mutex_queue.rear + 1) % CAPACITY;
+    mutex_queue.queue[mutex_queue.rear] = request;
+    mutex_queue.count++;
+    pthread_cond_signal(&mutex_queue.not_empty);
+    pthread_mutex_unlock(&mutex_queue.mutex);
+}
+
+static ProcessingRequest mutex_dequeue(void) {
+    pthread_mutex_lock(&mutex_queue.mutex);
+    while (mutex_queue.count <= 0) {
+        pthread_cond_wait(&mutex_queue.not_empty, &mutex_queue.mutex);
+    }
+    ProcessingRequest request = mutex_queue.queue[mutex_queue.front];
+    mutex_queue.front = (mutex_queue.front + 1) % CAPACITY;
+    mutex_queue.count--;
+    pthread_cond_signal(&mutex_queue.not_full);
+    pthread_mutex_unlock(&mutex_queue.mutex);
+    return request;
+}
+
+// --- driver ---
+
+static RequestQueue ring_queue;
+static int use_ring = 0;
+static int items_per_producer = 0;
+
+static void put(ProcessingRequest request) {
+    if (use_ring) {
+        enqueue(&ring_queue, request);
+    } else {
+        mutex_enqueue(request);
+    }
+}
+
+static ProcessingRequest take(void) {
+    return use_ring ? dequeue(&ring_queue) : mutex_dequeue();
+}
+
+static void* producer(void* arg) {
+    (void)arg;
+    ProcessingRequest request = { .type = REQUEST_COUNT_WORDS };
+    for (int i = 0; i < items_per_producer; i++) {
+        request.client_fd = i;
+        put(request);
+    }
+    return NULL;
+}
+
+static void* consumer(void* arg) {
+    (void)arg;
+    long received = 0;
+    for (;;) {
+        ProcessingRequest request = take();
+        if (request.type == 0) break;  // santinela de oprire
+        received++;
+    }
+    return (void*)received;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(int producers) {
+    pthread_t producer_tids[MAX_PRODUCERS];
+    pthread_t consumer_tids[CONSUMERS];
+    items_per_producer = TOTAL_ITEMS / producers;
+    
+    double start = now_seconds();
+    for (int i = 0; i < CONSUMERS; i++) {
+        pthread_create(&consumer_tids[i], NULL, consumer, NULL);
+    }
+    for (int i = 0; i < producers; i++) {
+        pthread_create(&producer_tids[i], NULL, producer, NULL);
+    }
+    for (int i = 0; i < producers; i++) {
+        pthread_join(producer_tids[i], NULL);
+    }
+    
+    ProcessingRequest stop = { .type = 0 };
+    for (int i = 0; i < CONSUMERS; i++) {
+        put(stop);
+    }
+    
+    long received = 0;
+    for (int i = 0; i < CONSUMERS; i++) {
+        void* count;
+        pthread_join(consumer_tids[i], &count);
+        received += (long)count;
+    }
+    double elapsed = now_seconds() - start;
+    
+    if (received != (long)items_per_producer * producers) {
+        fprintf(stderr, "Eroare: %ld elemente primite din %ld\n", received, (long)items_per_producer * producers);
+        exit(1);
+    }
+    return received / elapsed;
+}
+
+int main(void) {
+    mutex_init_queue();
+    if (init_queue(&ring_queue, CAPACITY) < 0) {
+        perror("Eroare la initializarea cozii");
+        return 1;
+    }
+    
+    printf("%d consumatori, %d elemente, capacitate %d\n", CONSUMERS, TOTAL_ITEMS, CAPACITY);
+    printf("%-12s %-18s %-18s %-8s\n", "Producatori", "mutex (op/s)", "inel (op/s)", "Raport");
+    
+    for (int producers = 1; producers <= MAX_PRODUCERS; producers *= 2) {
+        use_ring = 0;
+        double mutex_rate = run(producers);
+        use_ring = 1;
+        double ring_rate = run(producers);
+        printf("%-12d %-18.0f %-18.0f %-8.2f\n", producers, mutex_rate, ring_rate, ring_rate / mutex_rate);
+    }
+    
+    destroy_queue(&ring_queue);
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pcre.h>
+#include "../common/nlp.h"
+#include "../common/tokenizer.h"
+
+// Benchmark tokenize_text pe texte sintetice de 1 KB ... 64 KB.
+// Vocabularul creste odata cu textul (aproape fiecare cuvant e nou),
+// deci se vede direct cum scaleaza cautarea tokenilor existenti.
+// Pentru comparatie, doar gasirea cuvintelor: vechea cale cu PCRE
+// ([a-zA-Z]+, care taie cuvintele la diacritice) si next_token.
+
+#define MIN_SIZE 1024
+#define MAX_SIZE 65536
+#define MIN_SECONDS 0.2
+
+static unsigned int rng_state = 12345;
+
+static unsigned int next_random(void) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return rng_state >> 8;
+}
+
+// genereaza size bytes de cuvinte aleatoare, grupate in propozitii;
+// unele litere sunt diacritice (2 bytes), ca in textele romanesti
+static char* generate_text(size_t size) {
+    static const char* diacritics[] = { "\xc4\x83", "\xc3\xa2", "\xc3\xae", "\xc8\x99", "\xc8\x9b" };
+    char* text = malloc(size + 1);
+    if (!text) return NULL;
+    
+    size_t pos = 0;
+    int words_in_sentence = 0;
+    while (pos + 24 < size) {
+        int length = 4 + next_random() % 7;
+        for (int i = 0; i < length; i++) {
+            unsigned int r = next_random();
+            if (r % 16 == 0) {
+                memcpy(text + pos, diacritics[r / 16 % 5], 2);
+                pos += 2;
+            } else {
+                text[pos++] = 'a' + r % 26;
+            }
+        }
+        if (++words_in_sentence == 12) {
+            text[pos++] = '.';
+            words_in_sentence = 0;
+        }
+        text[pos++] = ' ';
+    }
+    while (pos < size) {
+        text[pos++] = ' ';
+    }
+    text[size] = '\0';
+    return text;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static pcre* word_re;
+static pcre_extra* word_extra;
+
+static int scan_pcre(const char* text, size_t length) {
+    int ovector[30];
+    int count = 0;
+    int start = 0;
+    while (pcre_exec(word_re, word_extra, text, (int)length, start, 0, ovector, 30) >= 0) {
+        count++;
+        start = ovector[1];
+    }
+    return count;
+}
+
+static int scan_tokenizer(const char* text, size_t length) {
+    int count = 0;
+    size_t pos = 0, start;
+    while (next_token(text, length, &pos, &start, 0) == TOKEN_WORD) {
+        count++;
+    }
+    return count;
+}
+
+static int run_tokenize(const char* text, size_t length) {
+    (void)length;
+    TokenizationResult* result = tokenize_text(text);
+    if (!result) {
+        return -1;
+    }
+    free_tokenization_result(result);
+    return 0;
+}
+
+// ns/byte pentru run, repetat cel putin MIN_SECONDS; negativ la eroare
+static double measure(int (*run)(const char*, size_t), const char* text, size_t size) {
+    int iterations = 0;
+    double start = now_seconds();
+    double elapsed;
+    do {
+        if (run(text, size) < 0) {
+            return -1.0;
+        }
+        iterations++;
+        elapsed = now_seconds() - start;
+    } while (elapsed < MIN_SECONDS);
+    
+    return elapsed / iterations * 1e9 / size;
+}
+
+int main(void) {
+    const char* error;
+    int erroffset;
+    word_re = pcre_compile("\\b[a-zA-Z]+\\b", 0, &error, &erroffset, NULL);
+    if (!word_re) {
+        fprintf(stderr, "PCRE compile error: %s\n", error);
+        return 1;
+    }
+    word_extra = pcre_study(word_re, 0, &error);
+    
+    printf("ns/byte\n");
+    printf("%-10s %-12s %-12s %-14s\n", "Bytes", "pcre", "next_token", "tokenize_text");
+    
+    for (size_t size = MIN_SIZE; size <= MAX_SIZE; size *= 2) {
+        char* text = generate_text(size);
+        if (!text) {
+            perror("Eroare la alocarea memoriei");
+            return 1;
+        }
+    
+        double pcre_rate = measure(scan_pcre, text, size);
+        double scan_rate = measure(scan_tokenizer, text, size);
+        double tokenize_rate = measure(run_tokenize, text, size);
+        if (tokenize_rate < 0) {
+            fprintf(stderr, "tokenize_text a esuat\n");
+            free(text);
+            return 1;
+        }
+    
+        printf("%-10zu %-12.2f %-12.2f %-14.2f\n", size, pcre_rate, scan_rate, tokenize_rate);
+        free(text);
+    }
+    
+    return 0;
+}
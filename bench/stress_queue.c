@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "../server/request_queue.h"
+
+// Test de stres pentru adormirea/trezirea thread-urilor in request_queue.c.
+// Coada e compilata cu QUEUE_PARK_DELAY_US (vezi Makefile), deci fiecare
+// thread care adoarme sta o vreme intre anuntare si reverificare, exact
+// fereastra in care o trezire se putea pierde. Un watchdog opreste testul
+// cu eroare daca niciun element nu mai trece prin coada.
+
+#define CAPACITY 128
+#define CONSUMERS 4
+#define ITEMS 20000
+#define ROUNDS 5
+#define STALL_SECONDS 5
+
+static RequestQueue queue;
+static atomic_long produced;
+static atomic_long consumed;
+
+static void* producer(void* arg) {
+    (void)arg;
+    ProcessingRequest request = { .type = REQUEST_COUNT_WORDS };
+    for (int i = 0; i < ITEMS; i++) {
+        request.client_fd = i;
+        enqueue(&queue, request);
+        atomic_fetch_add(&produced, 1);
+    }
+    // santinelele trec si ele prin coada, sub watchdog
+    ProcessingRequest stop = { .type = 0 };
+    for (int i = 0; i < CONSUMERS; i++) {
+        enqueue(&queue, stop);
+    }
+    return NULL;
+}
+
+static void* consumer(void* arg) {
+    (void)arg;
+    for (;;) {
+        ProcessingRequest request = dequeue(&queue);
+        atomic_fetch_add(&consumed, 1);
+        if (request.type == 0) break;  // santinela de oprire
+    }
+    return NULL;
+}
+
+// Asteapta pana trec target elemente (cu santinele); 0 daca nu mai avanseaza
+static int wait_for(long target) {
+    long last = -1;
+    int stalled = 0;
+    while (atomic_load(&consumed) < target) {
+        long now = atomic_load(&consumed);
+        stalled = now == last ? stalled + 1 : 0;
+        if (stalled >= STALL_SECONDS * 10) {
+            return 0;
+        }
+        last = now;
+        usleep(100000);
+    }
+    return 1;
+}
+
+int main(void) {
+    printf("%d consumatori, 1 producator, %d elemente, capacitate %d, %d runde\n",
+           CONSUMERS, ITEMS, CAPACITY, ROUNDS);
+    
+    for (int round = 1; round <= ROUNDS; round++) {
+        pthread_t producer_tid;
+        pthread_t consumer_tids[CONSUMERS];
+        if (init_queue(&queue, CAPACITY) < 0) {
+            perror("Eroare la initializarea cozii");
+            return 1;
+        }
+        atomic_store(&produced, 0);
+        atomic_store(&consumed, 0);
+        
+        for (int i = 0; i < CONSUMERS; i++) {
+            pthread_create(&consumer_tids[i], NULL, consumer, NULL);
+        }
+        pthread_create(&producer_tid, NULL, producer, NULL);
+        
+        if (!wait_for(ITEMS + CONSUMERS)) {
+            // threads blocate; procesul se termina fara join
+            fprintf(stderr, "Runda %d blocata: produse %ld, consumate %ld, in coada %d, "
+                    "asteapta %d consumatori / %d producatori\n",
+                    round, atomic_load(&produced), atomic_load(&consumed), queue_size(&queue),
+                    QUEUE_EVENT_WAITING(atomic_load(&queue.not_empty.state)),
+                    QUEUE_EVENT_WAITING(atomic_load(&queue.not_full.state)));
+            return 1;
+        }
+        pthread_join(producer_tid, NULL);
+        for (int i = 0; i < CONSUMERS; i++) {
+            pthread_join(consumer_tids[i], NULL);
+        }
+        destroy_queue(&queue);
+        printf("Runda %d: %d elemente\n", round, ITEMS);
+    }
+    return 0;
+}
@@ -23,7 +23,7 @@ int main(int argc, char *argv[]) {
         print_help();
         return 1;
     }
-
+    
     RequestType request_type;
     
     if (strcmp(argv[1], "--count-words") == 0) {
@@ -50,29 +50,27 @@ int main(int argc, char *argv[]) {
     long file_size = ftell(f);
     fseek(f, 0, SEEK_SET);
     
-    if (file_size > MAX_TEXT_SIZE) {
-        printf("Fișierul este prea mare, maxim %d bytes permis\n", MAX_TEXT_SIZE);
-        fclose(f);
-        return 1;
-    }
+    // Fișierele mai mari decât o cerere se trimit în flux, pe bucăți
+    int streaming = file_size >= MAX_TEXT_SIZE;
     
-    // Citește conținutul fișierului
-    char* buffer = (char*)malloc(file_size + 1);
+    // Citește conținutul fișierului (sau doar prima bucată)
+    size_t buffer_size = streaming ? MAX_TEXT_SIZE : (size_t)file_size;
+    char* buffer = (char*)malloc(buffer_size + 1);
     if (!buffer) {
         perror("Eroare la alocarea memoriei");
         fclose(f);
         return 1;
     }
     
-    size_t bytes_read = fread(buffer, 1, file_size, f);
+    size_t bytes_read = fread(buffer, 1, buffer_size, f);
     buffer[bytes_read] = '\0';
-    fclose(f);
     
     // Conectare la server
     int sockfd = socket(AF_INET, SOCK_STREAM, 0);
     if (sockfd < 0) {
         perror("Eroare la crearea socket-ului");
         free(buffer);
+        fclose(f);
         return 1;
     }
     
@@ -84,17 +82,42 @@ int main(int argc, char *argv[]) {
     if (connect(sockfd, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
         perror("Eroare la conectarea la server");
         free(buffer);
+        fclose(f);
         close(sockfd);
         return 1;
     }
+    enable_tcp_nodelay(sockfd);
     
     // Pregătirea și trimiterea cererii
     Request request;
+    request.version = PROTOCOL_VERSION;
     request.type = request_type;
-    strncpy(request.text, buffer, MAX_TEXT_SIZE - 1);
-    request.text[MAX_TEXT_SIZE - 1] = '\0';
+    request.flags = 0;
+    request.request_id = 0;
+    
+    int sent = 0;
+    if (streaming) {
+        // bucățile pleacă pe măsură ce sunt citite
+        while (sent == 0 && bytes_read > 0) {
+            sent = send_stream_chunk(sockfd, &request, buffer, bytes_read);
+            bytes_read = fread(buffer, 1, buffer_size, f);
+        }
+        if (sent == 0 && ferror(f)) {
+            sent = -1;
+        }
+        
+        // o bucată goală încheie documentul
+        if (sent == 0) {
+            sent = send_stream_chunk(sockfd, &request, NULL, 0);
+        }
+    } else {
+        strncpy(request.text, buffer, MAX_TEXT_SIZE - 1);
+        request.text[MAX_TEXT_SIZE - 1] = '\0';
+        sent = send_request(sockfd, &request);
+    }
+    fclose(f);
     
-    if (send_request(sockfd, &request) < 0) {
+    if (sent < 0) {
         perror("Eroare la trimiterea cererii");
         free(buffer);
         close(sockfd);
@@ -103,6 +126,8 @@ int main(int argc, char *argv[]) {
     
     // Primirea răspunsului
     Response response;
+    response.version = request.version;
+    response.flags = request.flags;
     if (receive_response(sockfd, &response) < 0) {
         perror("Eroare la primirea răspunsului");
         free(buffer);
@@ -127,6 +152,9 @@ int main(int argc, char *argv[]) {
                 printf("Rezumat:\n%s\n", response.summary);
                 printf("Timpul de procesare: %.2f secunde\n", response.processing_time);
                 break;
+                
+            default:
+                break;
         }
     } else {
         printf("Eroare: %s\n", response.error_message);
@@ -0,0 +1,415 @@
+#include "keywords.h"
+#include "tokenizer.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROOT 0
+#define SEPARATOR ' '
+#define MAX_KEYWORD_WORD 256    // ca token_buffer din add_token
+#define MAX_LINE_LENGTH 1024
+
+// muchie a trie-ului, doar in timpul construirii
+typedef struct {
+    int next;               // urmatoarea muchie din aceeasi stare, -1 = ultima
+    int target;
+    unsigned char byte;
+} TrieEdge;
+
+// domeniul unei fraze care se incheie intr-o stare
+typedef struct {
+    int domain;
+    int next;
+} TrieOutput;
+
+struct KeywordSet {
+    int strip_diacritics;
+    char** domains;
+    int domain_count;
+    int domain_capacity;
+    int phrase_count;
+    
+    // trie-ul frazelor (eliberat la build)
+    int state_count;
+    int state_capacity;
+    int* first_edge;        // stare -> prima muchie, -1 = niciuna
+    int* first_output;      // stare -> primul domeniu, -1 = niciunul
+    TrieEdge* edges;
+    int edge_count;
+    int edge_capacity;
+    TrieOutput* outputs;
+    int output_count;
+    int output_capacity;
+    
+    // automatul: tranzitii complete pe un alfabet comprimat
+    int built;
+    unsigned char symbols[256];     // byte -> simbol; 0 = byte din nicio fraza
+    int alphabet_size;
+    int* delta;                     // stare * alphabet_size + simbol -> stare
+    int* match_start;               // stare -> primul indice in matches (state_count + 1)
+    int* matches;                   // domeniile frazelor care se incheie in fiecare stare
+    int start;
+};
+
+// creste un tablou pana la cel putin needed elemente; -1 la eroare de alocare
+static int ensure_capacity(void** array, int* capacity, int needed, size_t element_size) {
+    if (needed <= *capacity) {
+        return 0;
+    }
+    
+    int new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    void* grown = realloc(*array, (size_t)new_capacity * element_size);
+    if (!grown) {
+        return -1;
+    }
+    *array = grown;
+    *capacity = new_capacity;
+    return 0;
+}
+
+static int add_state(KeywordSet* set) {
+    int capacity = set->state_capacity;
+    if (ensure_capacity((void**)&set->first_edge, &capacity, set->state_count + 1, sizeof(int)) < 0) {
+        return -1;
+    }
+    capacity = set->state_capacity;
+    if (ensure_capacity((void**)&set->first_output, &capacity, set->state_count + 1, sizeof(int)) < 0) {
+        return -1;
+    }
+    set->state_capacity = capacity;
+    
+    set->first_edge[set->state_count] = -1;
+    set->first_output[set->state_count] = -1;
+    return set->state_count++;
+}
+
+KeywordSet* keyword_set_create(int strip_diacritics) {
+    KeywordSet* set = (KeywordSet*)calloc(1, sizeof(KeywordSet));
+    if (!set) {
+        return NULL;
+    }
+    
+    set->strip_diacritics = strip_diacritics;
+    if (add_state(set) < 0) {
+        keyword_set_destroy(set);
+        return NULL;
+    }
+    return set;
+}
+
+void keyword_set_destroy(KeywordSet* set) {
+    if (!set) return;
+    
+    for (int i = 0; i < set->domain_count; i++) {
+        free(set->domains[i]);
+    }
+    free(set->domains);
+    free(set->first_edge);
+    free(set->first_output);
+    free(set->edges);
+    free(set->outputs);
+    free(set->delta);
+    free(set->match_start);
+    free(set->matches);
+    free(set);
+}
+
+int keyword_set_domain(KeywordSet* set, const char* name) {
+    for (int i = 0; i < set->domain_count; i++) {
+        if (strcmp(set->domains[i], name) == 0) {
+            return i;
+        }
+    }
+    
+    if (ensure_capacity((void**)&set->domains, &set->domain_capacity, set->domain_count + 1, sizeof(char*)) < 0) {
+        return -1;
+    }
+    set->domains[set->domain_count] = strdup(name);
+    if (!set->domains[set->domain_count]) {
+        return -1;
+    }
+    return set->domain_count++;
+}
+
+// starea in care duce byte din state, adaugata daca nu exista
+static int child_state(KeywordSet* set, int state, unsigned char byte) {
+    for (int e = set->first_edge[state]; e >= 0; e = set->edges[e].next) {
+        if (set->edges[e].byte == byte) {
+            return set->edges[e].target;
+        }
+    }
+    
+    int target = add_state(set);
+    if (target < 0 ||
+        ensure_capacity((void**)&set->edges, &set->edge_capacity, set->edge_count + 1, sizeof(TrieEdge)) < 0) {
+        return -1;
+    }
+    TrieEdge* edge = &set->edges[set->edge_count];
+    edge->next = set->first_edge[state];
+    edge->target = target;
+    edge->byte = byte;
+    set->first_edge[state] = set->edge_count++;
+    return target;
+}
+
+int keyword_set_add(KeywordSet* set, int domain, const char* phrase) {
+    if (set->built || domain < 0 || domain >= set->domain_count) {
+        return -1;
+    }
+    
+    size_t length = strlen(phrase);
+    size_t pos = 0;
+    size_t start;
+    char word[MAX_KEYWORD_WORD];
+    int words = 0;
+    int state = child_state(set, ROOT, SEPARATOR);
+    
+    while (state >= 0 && next_token(phrase, length, &pos, &start, 0) == TOKEN_WORD) {
+        int word_length = pos - start;
+        if (word_length >= MAX_KEYWORD_WORD) {
+            return 0;   // nu poate aparea ca token
+        }
+        memcpy(word, phrase + start, word_length);
+        word_length = fold_word(word, word_length, set->strip_diacritics);
+    
+        for (int i = 0; i < word_length && state >= 0; i++) {
+            state = child_state(set, state, (unsigned char)word[i]);
+        }
+        if (state >= 0) {
+            state = child_state(set, state, SEPARATOR);
+        }
+        words++;
+    }
+    
+    if (state < 0) {
+        return -1;
+    }
+    if (words == 0) {
+        return 0;
+    }
+    
+    for (int o = set->first_output[state]; o >= 0; o = set->outputs[o].next) {
+        if (set->outputs[o].domain == domain) {
+            return 0;
+        }
+    }
+    if (ensure_capacity((void**)&set->outputs, &set->output_capacity, set->output_count + 1, sizeof(TrieOutput)) < 0) {
+        return -1;
+    }
+    set->outputs[set->output_count].domain = domain;
+    set->outputs[set->output_count].next = set->first_output[state];
+    set->first_output[state] = set->output_count++;
+    set->phrase_count++;
+    return 0;
+}
+
+static char* trim(char* text) {
+    while (isspace((unsigned char)*text)) {
+        text++;
+    }
+    size_t length = strlen(text);
+    while (length > 0 && isspace((unsigned char)text[length - 1])) {
+        text[--length] = '\0';
+    }
+    return text;
+}
+
+int keyword_set_load(KeywordSet* set, const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    
+    char line[MAX_LINE_LENGTH];
+    int line_number = 0;
+    int domain = -1;
+    int result = 0;
+    
+    while (result == 0 && fgets(line, sizeof(line), f)) {
+        line_number++;
+        char* text = trim(line);
+        if (*text == '\0' || *text == '#') {
+            continue;
+        }
+    
+        if (*text == '[') {
+            char* end = strchr(text, ']');
+            if (!end || end == text + 1) {
+                fprintf(stderr, "%s:%d: secțiune invalidă\n", path, line_number);
+                result = -1;
+                continue;
+            }
+            *end = '\0';
+            domain = keyword_set_domain(set, trim(text + 1));
+            if (domain < 0) {
+                result = -1;
+            }
+            continue;
+        }
+    
+        if (domain < 0) {
+            fprintf(stderr, "%s:%d: cuvânt cheie în afara unei secțiuni [Domeniu]\n", path, line_number);
+            result = -1;
+        } else if (keyword_set_add(set, domain, text) < 0) {
+            result = -1;
+        }
+    }
+    
+    fclose(f);
+    return result;
+}
+
+// Tranzitiile lipsa ale fiecarei stari se completeaza din starea ei de
+// esec (cel mai lung sufix propriu care e si prefix al unei fraze), in
+// ordinea adancimii (BFS). O stare mosteneste si potrivirile starii de esec.
+int keyword_set_build(KeywordSet* set) {
+    if (set->built) {
+        return 0;
+    }
+    
+    memset(set->symbols, 0, sizeof(set->symbols));
+    int alphabet = 1;
+    for (int e = 0; e < set->edge_count; e++) {
+        if (!set->symbols[set->edges[e].byte]) {
+            set->symbols[set->edges[e].byte] = alphabet++;
+        }
+    }
+    
+    int states = set->state_count;
+    int* delta = (int*)malloc((size_t)states * alphabet * sizeof(int));
+    int* fail = (int*)malloc(states * sizeof(int));
+    int* order = (int*)malloc(states * sizeof(int));
+    int* match_start = (int*)calloc(states + 1, sizeof(int));
+    int* match_count = (int*)calloc(states, sizeof(int));
+    if (!delta || !fail || !order || !match_start || !match_count) {
+        free(delta);
+        free(fail);
+        free(order);
+        free(match_start);
+        free(match_count);
+        return -1;
+    }
+    
+    for (int s = 0; s < states; s++) {
+        for (int a = 0; a < alphabet; a++) {
+            delta[s * alphabet + a] = -1;
+        }
+        for (int e = set->first_edge[s]; e >= 0; e = set->edges[e].next) {
+            delta[s * alphabet + set->symbols[set->edges[e].byte]] = set->edges[e].target;
+        }
+    }
+    
+    int head = 0, tail = 0;
+    fail[ROOT] = ROOT;
+    for (int a = 0; a < alphabet; a++) {
+        int target = delta[ROOT * alphabet + a];
+        if (target < 0) {
+            delta[ROOT * alphabet + a] = ROOT;
+        } else {
+            fail[target] = ROOT;
+            order[tail++] = target;
+        }
+    }
+    while (head < tail) {
+        int s = order[head++];
+        for (int a = 0; a < alphabet; a++) {
+            int target = delta[s * alphabet + a];
+            int fallback = delta[fail[s] * alphabet + a];
+            if (target < 0) {
+                delta[s * alphabet + a] = fallback;
+            } else {
+                fail[target] = fallback;
+                order[tail++] = target;
+            }
+        }
+    }
+    
+    // potrivirile: proprii + ale starii de esec (calculate inaintea ei)
+    for (int i = 0; i < tail; i++) {
+        int s = order[i];
+        int own = 0;
+        for (int o = set->first_output[s]; o >= 0; o = set->outputs[o].next) {
+            own++;
+        }
+        match_count[s] = own + match_count[fail[s]];
+    }
+    for (int s = 0; s < states; s++) {
+        match_start[s + 1] = match_start[s] + match_count[s];
+    }
+    
+    int* matches = (int*)malloc((match_start[states] > 0 ? match_start[states] : 1) * sizeof(int));
+    if (!matches) {
+        free(delta);
+        free(fail);
+        free(order);
+        free(match_start);
+        free(match_count);
+        return -1;
+    }
+    for (int i = 0; i < tail; i++) {
+        int s = order[i];
+        int out = match_start[s];
+        for (int o = set->first_output[s]; o >= 0; o = set->outputs[o].next) {
+            matches[out++] = set->outputs[o].domain;
+        }
+        for (int m = match_start[fail[s]]; m < match_start[fail[s] + 1]; m++) {
+            matches[out++] = matches[m];
+        }
+    }
+    
+    free(fail);
+    free(order);
+    free(match_count);
+    free(set->first_edge);
+    free(set->first_output);
+    free(set->edges);
+    free(set->outputs);
+    set->first_edge = NULL;
+    set->first_output = NULL;
+    set->edges = NULL;
+    set->outputs = NULL;
+    
+    set->alphabet_size = alphabet;
+    set->delta = delta;
+    set->match_start = match_start;
+    set->matches = matches;
+    set->start = delta[ROOT * alphabet + set->symbols[SEPARATOR]];
+    set->built = 1;
+    return 0;
+}
+
+int keyword_set_domain_count(const KeywordSet* set) {
+    return set->domain_count;
+}
+
+const char* keyword_set_domain_name(const KeywordSet* set, int domain) {
+    return set->domains[domain];
+}
+
+int keyword_set_phrase_count(const KeywordSet* set) {
+    return set->phrase_count;
+}
+
+int keyword_set_start(const KeywordSet* set) {
+    return set->start;
+}
+
+int keyword_set_feed(const KeywordSet* set, int state, const char* word, int length, int* scores) {
+    const int* delta = set->delta;
+    int alphabet = set->alphabet_size;
+    
+    for (int i = 0; i < length; i++) {
+        state = delta[state * alphabet + set->symbols[(unsigned char)word[i]]];
+    }
+    state = delta[state * alphabet + set->symbols[SEPARATOR]];
+    
+    for (int m = set->match_start[state]; m < set->match_start[state + 1]; m++) {
+        scores[set->matches[m]]++;
+    }
+    return state;
+}
@@ -0,0 +1,48 @@
+#ifndef KEYWORDS_H
+#define KEYWORDS_H
+
+/* Cuvinte cheie pe domenii, compilate intr-un automat Aho-Corasick.
+ * Automatul citeste textul normalizat ca sir de cuvinte despartite de
+ * cate un spatiu (" w1 w2 w3 "), iar fiecare fraza e cautata ca " k1 k2 ",
+ * deci se potrivesc doar cuvinte intregi, iar frazele de mai multe cuvinte
+ * se gasesc in aceeasi trecere. Cuvintele frazelor sunt normalizate ca
+ * tokenii (next_token + fold_word). Dupa keyword_set_build, setul e doar
+ * citit si poate fi folosit din mai multe thread-uri. */
+
+typedef struct KeywordSet KeywordSet;
+
+// strip_diacritics: la fel ca pentru tokeni (vezi fold_word)
+KeywordSet* keyword_set_create(int strip_diacritics);
+
+void keyword_set_destroy(KeywordSet* set);
+
+// indexul domeniului, adaugat daca nu exista; -1 la eroare de alocare
+int keyword_set_domain(KeywordSet* set, const char* name);
+
+// fraze fara niciun cuvant sunt ignorate; -1 la eroare de alocare
+int keyword_set_add(KeywordSet* set, int domain, const char* phrase);
+
+// Fisier text UTF-8: "[Domeniu]" incepe o sectiune, fiecare linie
+// urmatoare e un cuvant sau o fraza; liniile goale si cele care incep cu
+// '#' sunt ignorate. -1 daca fisierul nu poate fi citit sau e invalid.
+int keyword_set_load(KeywordSet* set, const char* path);
+
+// Construieste automatul; dupa aceea nu se mai pot adauga cuvinte
+int keyword_set_build(KeywordSet* set);
+
+int keyword_set_domain_count(const KeywordSet* set);
+
+const char* keyword_set_domain_name(const KeywordSet* set, int domain);
+
+int keyword_set_phrase_count(const KeywordSet* set);
+
+// Starea de la inceputul textului si de dupa un terminator de propozitie
+// (frazele nu trec de la o propozitie la alta)
+int keyword_set_start(const KeywordSet* set);
+
+// Trece un cuvant deja normalizat si spatiul de dupa el. Pentru fiecare
+// fraza care se incheie cu acest cuvant, scores[domeniul ei]++.
+// Intoarce starea noua.
+int keyword_set_feed(const KeywordSet* set, int state, const char* word, int length, int* scores);
+
+#endif
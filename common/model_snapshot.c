@@ -0,0 +1,471 @@
+#include "model_snapshot.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char snapshot_magic[8] = { 'N', 'L', 'P', 'B', 'A', 'Y', 'E', 'S' };
+
+#define FLAG_STRIP_DIACRITICS 1
+
+#define WRITE_BUFFER_SIZE 65536
+#define MIN_VOCABULARY_CAPACITY 256
+
+// FNV-1a pe cuvinte de 64 de biti: un singur produs la 8 bytes
+#define CHECKSUM_SEED 14695981039346656037ull
+#define CHECKSUM_PRIME 1099511628211ull
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define HOST_LITTLE_ENDIAN 0
+#else
+#define HOST_LITTLE_ENDIAN 1
+#endif
+
+static void store_le(unsigned char* out, uint64_t value, int size) {
+    for (int i = 0; i < size; i++) {
+        out[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static uint64_t load_le(const unsigned char* data, int size) {
+    uint64_t value = 0;
+    for (int i = size - 1; i >= 0; i--) {
+        value = value << 8 | data[i];
+    }
+    return value;
+}
+
+static size_t align8(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+// data are un multiplu de 8 bytes si e aliniat la 8
+static uint64_t update_checksum(uint64_t checksum, const unsigned char* data, size_t size) {
+    for (size_t i = 0; i < size; i += 8) {
+        checksum ^= HOST_LITTLE_ENDIAN ? *(const uint64_t*)(data + i) : load_le(data + i, 8);
+        checksum *= CHECKSUM_PRIME;
+    }
+    return checksum;
+}
+
+// Dimensiunile sectiunilor, calculate din antet si din tabela domeniilor
+typedef struct {
+    size_t domains;
+    size_t offsets;
+    size_t hashes;
+    size_t slots;
+    size_t counts;      // sectiunile tuturor domeniilor
+    size_t strings;
+    size_t total;
+} SnapshotLayout;
+
+static void compute_layout(SnapshotLayout* layout, uint64_t domain_count, uint64_t word_count,
+                           uint64_t slot_capacity, uint64_t total_entries, uint64_t domain_entries_padding,
+                           uint64_t strings_size) {
+    layout->domains = domain_count * MODEL_SNAPSHOT_DOMAIN_SIZE;
+    layout->offsets = align8(word_count * 4);
+    layout->hashes = align8(word_count * 4);
+    layout->slots = align8(slot_capacity * 4);
+    layout->counts = total_entries * 12 + domain_entries_padding;
+    layout->strings = align8(strings_size);
+    layout->total = MODEL_SNAPSHOT_HEADER_SIZE + layout->domains + layout->offsets + layout->hashes +
+                    layout->slots + layout->counts + layout->strings;
+}
+
+
+// Scriere cu buffer; suma de control se calculeaza pe masura ce se scrie
+typedef struct {
+    FILE* file;
+    unsigned char buffer[WRITE_BUFFER_SIZE];
+    size_t used;
+    uint64_t checksum;
+    size_t written;
+    int failed;
+} SnapshotWriter;
+
+static void writer_flush(SnapshotWriter* writer) {
+    // doar cuvinte intregi de 8 bytes; restul asteapta urmatoarea scriere
+    size_t whole = writer->used & ~(size_t)7;
+    writer->checksum = update_checksum(writer->checksum, writer->buffer, whole);
+    if (whole > 0 && fwrite(writer->buffer, 1, whole, writer->file) != whole) {
+        writer->failed = 1;
+    }
+    memmove(writer->buffer, writer->buffer + whole, writer->used - whole);
+    writer->used -= whole;
+}
+
+static void writer_put(SnapshotWriter* writer, const void* data, size_t size) {
+    const unsigned char* in = (const unsigned char*)data;
+    writer->written += size;
+    while (size > 0) {
+        size_t room = WRITE_BUFFER_SIZE - writer->used;
+        size_t chunk = size < room ? size : room;
+        memcpy(writer->buffer + writer->used, in, chunk);
+        writer->used += chunk;
+        in += chunk;
+        size -= chunk;
+        if (writer->used == WRITE_BUFFER_SIZE) {
+            writer_flush(writer);
+        }
+    }
+}
+
+static void writer_put_le(SnapshotWriter* writer, uint64_t value, int size) {
+    unsigned char bytes[8];
+    store_le(bytes, value, size);
+    writer_put(writer, bytes, size);
+}
+
+static void writer_pad(SnapshotWriter* writer) {
+    static const unsigned char zeros[8];
+    writer_put(writer, zeros, align8(writer->written) - writer->written);
+}
+
+// tablou de elemente de 4 sau 8 bytes din memorie, scris little-endian
+static void writer_put_array(SnapshotWriter* writer, const void* data, size_t count, int size) {
+    if (HOST_LITTLE_ENDIAN) {
+        writer_put(writer, data, count * size);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        uint64_t value = size == 4 ? ((const uint32_t*)data)[i] : ((const uint64_t*)data)[i];
+        writer_put_le(writer, value, size);
+    }
+}
+
+// cate intrari din domeniu se scriu: cel mult cate cuvinte are vocabularul
+static int stored_entries(const BayesClassifier* classifier, const DomainBayes* domain) {
+    return domain->capacity < classifier->vocabulary.count ? domain->capacity : classifier->vocabulary.count;
+}
+
+long long save_model_snapshot(const BayesClassifier* classifier, int strip_diacritics, const char* path) {
+    const Vocabulary* vocabulary = &classifier->vocabulary;
+    char temp_path[4096];
+    if (snprintf(temp_path, sizeof(temp_path), "%s.tmp", path) >= (int)sizeof(temp_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    
+    SnapshotWriter* writer = (SnapshotWriter*)calloc(1, sizeof(SnapshotWriter));
+    if (!writer) {
+        return -1;
+    }
+    writer->file = fopen(temp_path, "wb");
+    if (!writer->file) {
+        free(writer);
+        return -1;
+    }
+    writer->checksum = CHECKSUM_SEED;
+    
+    // antetul se scrie la sfarsit, dupa suma de control
+    _Alignas(8) unsigned char header[MODEL_SNAPSHOT_HEADER_SIZE] = {0};
+    if (fwrite(header, 1, sizeof(header), writer->file) != sizeof(header)) {
+        writer->failed = 1;
+    }
+    
+    uint64_t strings_size = 0;
+    for (int i = 0; i < vocabulary->count; i++) {
+        strings_size += strlen(vocabulary->words[i]) + 1;
+    }
+    uint64_t names_offset = strings_size;
+    for (int d = 0; d < classifier->count; d++) {
+        strings_size += strlen(classifier->domains[d].domain) + 1;
+    }
+    
+    uint64_t name_offset = names_offset;
+    for (int d = 0; d < classifier->count; d++) {
+        const DomainBayes* domain = &classifier->domains[d];
+        writer_put_le(writer, name_offset, 4);
+        writer_put_le(writer, domain->document_count, 4);
+        writer_put_le(writer, domain->word_count_size, 4);
+        writer_put_le(writer, stored_entries(classifier, domain), 4);
+        writer_put_le(writer, domain->total_words, 8);
+        writer_put_le(writer, 0, 8);
+        name_offset += strlen(domain->domain) + 1;
+    }
+    
+    uint64_t word_offset = 0;
+    for (int i = 0; i < vocabulary->count; i++) {
+        writer_put_le(writer, word_offset, 4);
+        word_offset += strlen(vocabulary->words[i]) + 1;
+    }
+    writer_pad(writer);
+    writer_put_array(writer, vocabulary->hashes, vocabulary->count, 4);
+    writer_pad(writer);
+    writer_put_array(writer, vocabulary->slots, vocabulary->slot_capacity, 4);
+    writer_pad(writer);
+    
+    for (int d = 0; d < classifier->count; d++) {
+        const DomainBayes* domain = &classifier->domains[d];
+        int entries = stored_entries(classifier, domain);
+        writer_put_array(writer, domain->word_counts, entries, 4);
+        writer_pad(writer);
+        writer_put_array(writer, domain->log_counts, entries, 8);
+    }
+    
+    for (int i = 0; i < vocabulary->count; i++) {
+        writer_put(writer, vocabulary->words[i], strlen(vocabulary->words[i]) + 1);
+    }
+    for (int d = 0; d < classifier->count; d++) {
+        writer_put(writer, classifier->domains[d].domain, strlen(classifier->domains[d].domain) + 1);
+    }
+    writer_pad(writer);
+    writer_flush(writer);
+    
+    uint64_t file_size = MODEL_SNAPSHOT_HEADER_SIZE + writer->written;
+    memcpy(header, snapshot_magic, sizeof(snapshot_magic));
+    store_le(header + 8, MODEL_SNAPSHOT_VERSION, 4);
+    store_le(header + 12, strip_diacritics ? FLAG_STRIP_DIACRITICS : 0, 4);
+    store_le(header + 16, file_size, 8);
+    store_le(header + 32, classifier->count, 4);
+    store_le(header + 36, vocabulary->count, 4);
+    store_le(header + 40, vocabulary->slot_capacity, 4);
+    store_le(header + 44, classifier->total_documents, 4);
+    store_le(header + 48, strings_size, 8);
+    // suma acopera si antetul, cu campul ei inca zero
+    store_le(header + 24, update_checksum(writer->checksum, header, sizeof(header)), 8);
+    
+    if (fseek(writer->file, 0, SEEK_SET) != 0 ||
+        fwrite(header, 1, sizeof(header), writer->file) != sizeof(header)) {
+        writer->failed = 1;
+    }
+    if (fflush(writer->file) != 0 || fsync(fileno(writer->file)) != 0) {
+        writer->failed = 1;
+    }
+    if (fclose(writer->file) != 0) {
+        writer->failed = 1;
+    }
+    
+    int failed = writer->failed;
+    free(writer);
+    if (failed || rename(temp_path, path) < 0) {
+        int saved_errno = errno;
+        unlink(temp_path);
+        errno = saved_errno;
+        return -1;
+    }
+    return (long long)file_size;
+}
+
+
+// tablou little-endian din mapare -> memorie
+static void copy_array(void* out, const unsigned char* data, size_t count, int size) {
+    if (HOST_LITTLE_ENDIAN) {
+        memcpy(out, data, count * size);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (size == 4) {
+            ((uint32_t*)out)[i] = (uint32_t)load_le(data + 4 * i, 4);
+        } else {
+            ((uint64_t*)out)[i] = load_le(data + 8 * i, 8);
+        }
+    }
+}
+
+static BayesClassifier* snapshot_error(const char* path, const char* reason, BayesClassifier* classifier) {
+    fprintf(stderr, "%s: %s\n", path, reason);
+    free_bayes_classifier(classifier);
+    return NULL;
+}
+
+// tablourile unui domeniu, cu loc pentru cel putin entries intrari
+static int load_domain(DomainBayes* domain, const unsigned char* record, const unsigned char* counts,
+                       const char* strings, uint64_t strings_size) {
+    uint64_t name_offset = load_le(record, 4);
+    int entries = (int)load_le(record + 12, 4);
+    if (name_offset >= strings_size) {
+        return -1;
+    }
+    
+    domain->domain = strdup(strings + name_offset);
+    domain->document_count = (int)load_le(record + 4, 4);
+    domain->word_count_size = (int)load_le(record + 8, 4);
+    domain->total_words = (long)load_le(record + 16, 8);
+    if (!domain->domain) {
+        return -1;
+    }
+    if (entries == 0) {
+        return 0;
+    }
+    
+    domain->word_counts = (int*)malloc(entries * sizeof(int));
+    domain->log_counts = (double*)malloc(entries * sizeof(double));
+    if (!domain->word_counts || !domain->log_counts) {
+        return -1;
+    }
+    domain->capacity = entries;
+    copy_array(domain->word_counts, counts, entries, 4);
+    copy_array(domain->log_counts, counts + align8(entries * 4), entries, 8);
+    return 0;
+}
+
+BayesClassifier* load_model_snapshot(const char* path, int strip_diacritics) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return NULL;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        perror(path);
+        close(fd);
+        return NULL;
+    }
+    if ((uint64_t)st.st_size < MODEL_SNAPSHOT_HEADER_SIZE) {
+        close(fd);
+        return snapshot_error(path, "snapshot trunchiat", NULL);
+    }
+    
+    size_t size = (size_t)st.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        perror(path);
+        return NULL;
+    }
+    const unsigned char* data = (const unsigned char*)mapping;
+    
+    BayesClassifier* classifier = (BayesClassifier*)calloc(1, sizeof(BayesClassifier));
+    if (!classifier) {
+        munmap(mapping, size);
+        return snapshot_error(path, "memorie insuficientă", NULL);
+    }
+    // de aici maparea e eliberata impreuna cu clasificatorul
+    classifier->snapshot = mapping;
+    classifier->snapshot_size = size;
+    
+    if (memcmp(data, snapshot_magic, sizeof(snapshot_magic)) != 0) {
+        return snapshot_error(path, "nu este un snapshot de model", classifier);
+    }
+    if (load_le(data + 8, 4) != MODEL_SNAPSHOT_VERSION) {
+        return snapshot_error(path, "versiune de snapshot necunoscută", classifier);
+    }
+    if ((load_le(data + 12, 4) & FLAG_STRIP_DIACRITICS) != (strip_diacritics ? FLAG_STRIP_DIACRITICS : 0)) {
+        return snapshot_error(path, "modelul a fost salvat cu alt mod --diacritics", classifier);
+    }
+    if (load_le(data + 16, 8) != size) {
+        return snapshot_error(path, "dimensiunea nu corespunde antetului (fișier trunchiat?)", classifier);
+    }
+    
+    uint64_t domain_count = load_le(data + 32, 4);
+    uint64_t word_count = load_le(data + 36, 4);
+    uint64_t slot_capacity = load_le(data + 40, 4);
+    uint64_t strings_size = load_le(data + 48, 8);
+    
+    // intrarile domeniilor, din tabela lor (inainte de suma de control,
+    // fiindca de ele depinde cat de mare trebuie sa fie fisierul)
+    if (domain_count == 0 || domain_count > INT32_MAX || word_count > INT32_MAX || slot_capacity > INT32_MAX ||
+        MODEL_SNAPSHOT_HEADER_SIZE + domain_count * MODEL_SNAPSHOT_DOMAIN_SIZE > size) {
+        return snapshot_error(path, "antet invalid", classifier);
+    }
+    const unsigned char* records = data + MODEL_SNAPSHOT_HEADER_SIZE;
+    uint64_t total_entries = 0;
+    uint64_t padding = 0;
+    for (uint64_t d = 0; d < domain_count; d++) {
+        uint64_t entries = load_le(records + d * MODEL_SNAPSHOT_DOMAIN_SIZE + 12, 4);
+        if (entries > word_count) {
+            return snapshot_error(path, "antet invalid", classifier);
+        }
+        total_entries += entries;
+        padding += align8(entries * 4) - entries * 4;
+    }
+    
+    SnapshotLayout layout;
+    compute_layout(&layout, domain_count, word_count, slot_capacity, total_entries, padding, strings_size);
+    if (strings_size > size || layout.total != size) {
+        return snapshot_error(path, "dimensiunea nu corespunde antetului", classifier);
+    }
+    _Alignas(8) unsigned char header[MODEL_SNAPSHOT_HEADER_SIZE];
+    memcpy(header, data, sizeof(header));
+    memset(header + 24, 0, 8);
+    uint64_t checksum = update_checksum(CHECKSUM_SEED, data + MODEL_SNAPSHOT_HEADER_SIZE,
+                                        size - MODEL_SNAPSHOT_HEADER_SIZE);
+    if (update_checksum(checksum, header, sizeof(header)) != load_le(data + 24, 8)) {
+        return snapshot_error(path, "suma de control nu corespunde (fișier corupt)", classifier);
+    }
+    
+    const unsigned char* offsets = records + layout.domains;
+    const unsigned char* hashes = offsets + layout.offsets;
+    const unsigned char* slots = hashes + layout.hashes;
+    const unsigned char* counts = slots + layout.slots;
+    const char* strings = (const char*)(counts + layout.counts);
+    if (strings_size == 0 || strings[strings_size - 1] != '\0' ||
+        (slot_capacity & (slot_capacity - 1)) != 0 || slot_capacity < 2 * word_count || slot_capacity == 0) {
+        return snapshot_error(path, "date invalide", classifier);
+    }
+    
+    classifier->total_documents = (int)load_le(data + 44, 4);
+    classifier->domains = (DomainBayes*)calloc(domain_count, sizeof(DomainBayes));
+    if (!classifier->domains) {
+        return snapshot_error(path, "memorie insuficientă", classifier);
+    }
+    classifier->count = (int)domain_count;
+    
+    for (int d = 0; d < classifier->count; d++) {
+        const unsigned char* record = records + d * MODEL_SNAPSHOT_DOMAIN_SIZE;
+        int entries = (int)load_le(record + 12, 4);
+        if (load_domain(&classifier->domains[d], record, counts, strings, strings_size) < 0) {
+            return snapshot_error(path, "date invalide sau memorie insuficientă", classifier);
+        }
+        counts += align8(entries * 4) + entries * 8;
+    
+        DomainBayes* domain = &classifier->domains[d];
+        domain->probability = classifier->total_documents > 0 ?
+            (double)domain->document_count / classifier->total_documents : 1.0 / classifier->count;
+    }
+    
+    // vocabularul: cuvintele raman in mapare, restul se copiaza
+    Vocabulary* vocabulary = &classifier->vocabulary;
+    vocabulary->capacity = word_count > MIN_VOCABULARY_CAPACITY ? (int)word_count : MIN_VOCABULARY_CAPACITY;
+    vocabulary->words = (char**)malloc(vocabulary->capacity * sizeof(char*));
+    vocabulary->hashes = (unsigned int*)malloc(vocabulary->capacity * sizeof(unsigned int));
+    vocabulary->slots = (int*)malloc(slot_capacity * sizeof(int));
+    vocabulary->slot_capacity = (int)slot_capacity;
+    vocabulary->pool = strings;
+    vocabulary->pool_size = strings_size;
+    if (!vocabulary->words || !vocabulary->hashes || !vocabulary->slots) {
+        return snapshot_error(path, "memorie insuficientă", classifier);
+    }
+    
+    for (uint64_t i = 0; i < word_count; i++) {
+        uint64_t offset = load_le(offsets + 4 * i, 4);
+        if (offset >= strings_size) {
+            return snapshot_error(path, "date invalide", classifier);
+        }
+        vocabulary->words[vocabulary->count++] = (char*)strings + offset;
+    }
+    copy_array(vocabulary->hashes, hashes, word_count, 4);
+    copy_array(vocabulary->slots, slots, slot_capacity, 4);
+    
+    // fiecare id exact o data, ca sa ramana sloturi goale (cautarea se opreste
+    // la ele) si ca niciun cuvant sa nu fie de negasit
+    unsigned char* seen = (unsigned char*)calloc(word_count / 8 + 1, 1);
+    if (!seen) {
+        return snapshot_error(path, "memorie insuficientă", classifier);
+    }
+    uint64_t used = 0;
+    for (uint64_t i = 0; i < slot_capacity; i++) {
+        int id = vocabulary->slots[i];
+        if (id < -1 || id >= (int)word_count || (id >= 0 && (seen[id / 8] >> (id % 8) & 1))) {
+            free(seen);
+            return snapshot_error(path, "date invalide", classifier);
+        }
+        if (id >= 0) {
+            seen[id / 8] |= 1 << (id % 8);
+            used++;
+        }
+    }
+    free(seen);
+    if (used != word_count) {
+        return snapshot_error(path, "date invalide", classifier);
+    }
+    
+    return classifier;
+}
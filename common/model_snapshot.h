@@ -0,0 +1,38 @@
+#ifndef MODEL_SNAPSHOT_H
+#define MODEL_SNAPSHOT_H
+
+#include "nlp.h"
+
+/* Snapshot binar al clasificatorului Bayes: vocabularul (cuvinte, hash-uri,
+ * tabela de sloturi) si, pentru fiecare domeniu, contoarele si logaritmii
+ * lor, exact in forma folosita in memorie. Toate campurile sunt
+ * little-endian, iar fiecare sectiune e aliniata la 8 bytes.
+ *
+ *   antet (MODEL_SNAPSHOT_HEADER_SIZE bytes): magic, versiune, flag-uri,
+ *       dimensiunea fisierului, suma de control, numaratori
+ *   (suma acopera sectiunile de dupa antet si apoi antetul, cu campul
+ *   sumei pus pe zero)
+ *   domenii: cate o inregistrare de MODEL_SNAPSHOT_DOMAIN_SIZE bytes
+ *   offset-urile cuvintelor (u32), hash-urile (u32), sloturile (i32)
+ *   pentru fiecare domeniu: contoarele (i32), apoi log(contor + 1) (f64)
+ *   sirurile: cuvintele si numele domeniilor, terminate cu '\0'
+ *
+ * La incarcare fisierul e mapat read-only: cuvintele sunt folosite direct
+ * din mapare, iar tablourile numerice se copiaza in bloc (fara re-hash si
+ * fara log), deci un model mare se incarca in milisecunde. */
+
+#define MODEL_SNAPSHOT_VERSION 2
+#define MODEL_SNAPSHOT_HEADER_SIZE 64
+#define MODEL_SNAPSHOT_DOMAIN_SIZE 32
+
+// Scrie modelul intr-un fisier temporar si il redenumeste peste path, deci
+// un snapshot mapat anterior ramane valid. strip_diacritics e modul in care
+// au fost produsi tokenii. Intoarce dimensiunea fisierului sau -1 (errno).
+long long save_model_snapshot(const BayesClassifier* classifier, int strip_diacritics, const char* path);
+
+// NULL daca fisierul nu poate fi citit, e corupt, are alta versiune sau a
+// fost salvat cu alt mod de diacritice; motivul se afiseaza pe stderr.
+// Maparea e eliberata de free_bayes_classifier.
+BayesClassifier* load_model_snapshot(const char* path, int strip_diacritics);
+
+#endif
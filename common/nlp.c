@@ -1,36 +1,20 @@
+#define _GNU_SOURCE
 #include "nlp.h"
-#include <pcre.h>
+#include "stopwords_table.h"
+#include "keywords.h"
+#include "tokenizer.h"
+#include "word_count.h"
+#include <pthread.h>
 #include <string.h>
+#include <strings.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <ctype.h>
 #include <math.h>
+#include <sys/mman.h>
 
 
-static char* stopwords[] = {
-    "a", "about", "above", "after", "again", "against", "all", "am", "an", "and", "any", "are",
-    "as", "at", "be", "because", "been", "before", "being", "below", "between", "both", "but",
-    "by", "could", "did", "do", "does", "doing", "down", "during", "each", "few", "for", "from",
-    "further", "had", "has", "have", "having", "he", "he'd", "he'll", "he's", "her", "here",
-    "here's", "hers", "herself", "him", "himself", "his", "how", "how's", "i", "i'd", "i'll",
-    "i'm", "i've", "if", "in", "into", "is", "it", "it's", "its", "itself", "let's", "me",
-    "more", "most", "my", "myself", "nor", "of", "on", "once", "only", "or", "other", "ought",
-    "our", "ours", "ourselves", "out", "over", "own", "same", "she", "she'd", "she'll", "she's",
-    "should", "so", "some", "such", "than", "that", "that's", "the", "their", "theirs", "them",
-    "themselves", "then", "there", "there's", "these", "they", "they'd", "they'll", "they're",
-    "they've", "this", "those", "through", "to", "too", "under", "until", "up", "very", "was",
-    "we", "we'd", "we'll", "we're", "we've", "were", "what", "what's", "when", "when's", "where",
-    "where's", "which", "while", "who", "who's", "whom", "why", "why's", "with", "would", "you",
-    "you'd", "you'll", "you're", "you've", "your", "yours", "yourself", "yourselves",
-    // RO stopwordss
-    "si", "in", "a", "al", "ale", "pe", "la", "care", "ce", "cu", "din", "despre", "pentru",
-    "este", "sunt", "ca", "mai", "sau", "de", "nu", "sa", "o", "la", "dar", "unui", "unei",
-    "acest", "aceasta", "acesta", "aceștia", "acestea", "prin", "iar", "fi", "fost", "ei",
-    "ea", "el", "lor", "lui", "său", "sa", "său"
-};
-#define STOPWORDS_COUNT (sizeof(stopwords) / sizeof(stopwords[0]))
 
-// struct for keywords for diff topics
+// built-in keywords for diff topics (keyword files can add more)
 typedef struct {
     char* domain;
     char** keywords;
@@ -60,578 +44,1971 @@ static DomainKeywords domains[] = {
 #define DOMAINS_COUNT (sizeof(domains) / sizeof(domains[0]))
 
 
+// open-addressing slot: index into tokens[] (-1 = empty) and cached hash
+typedef struct {
+    int index;
+    unsigned int hash;
+} TokenSlot;
+
 // tokenizer resp
+// tokens[] keeps insertion order for iteration, slots[] is the lookup table
 struct TokenizationResult {
     Token* tokens;
     int count;
     int capacity;
+    TokenSlot* slots;
+    int slot_capacity;  // power of 2, kept at most half full
+    Arena* arena;       // owner of all the memory above, or NULL (malloc)
+    // every word, stopwords included, also goes through the keyword automaton
+    const KeywordSet* keywords;
+    int keyword_state;
+    int* topic_scores;  // keyword matches per domain
 };
 
-// stuct for sentence
+// stuct for sentence; text points into the analyzed text (not terminated)
 typedef struct {
-    char* text;
+    const char* text;
+    int offset;
+    int length;
     double score;
+    int word_count;
+    const int* terms;       // distinct tokens, see SentenceSpan
+    int term_count;
 } Sentence;
 
+// words are scanned by next_token (tokenizer.c); tokens are folded to
+// lowercase and, if enabled, stripped of diacritics
+static int strip_diacritics = 0;
 
-static int is_stopword(const char* word) {
-    for (int i = 0; i < STOPWORDS_COUNT; i++) {
-        if (strcasecmp(word, stopwords[i]) == 0) {
-            return 1;
-        }
-    }
-    return 0;
+void set_strip_diacritics(int enabled) {
+    strip_diacritics = enabled;
 }
 
-BayesClassifier* init_bayes_classifier() {
-    BayesClassifier* classifier = (BayesClassifier*)malloc(sizeof(BayesClassifier));
-    if (!classifier) return NULL;
-    
-    classifier->count = 3; 
-    classifier->total_documents = 0;
-    classifier->domains = (DomainBayes*)malloc(classifier->count * sizeof(DomainBayes));
-    
-    if (!classifier->domains) {
-        free(classifier);
+// the tables above and the keyword files, compiled into one automaton;
+// built on first use unless load_topic_keywords already built it
+static KeywordSet* topic_keywords = NULL;
+static pthread_once_t keywords_once = PTHREAD_ONCE_INIT;
+
+static KeywordSet* create_topic_keywords(void) {
+    KeywordSet* set = keyword_set_create(strip_diacritics);
+    if (!set) {
         return NULL;
     }
     
-    classifier->domains[0].domain = strdup("Sport");
-    classifier->domains[0].probability = 1.0/3.0;
-    classifier->domains[0].document_count = 0;
-    classifier->domains[0].word_counts = NULL;
-    classifier->domains[0].word_count_size = 0;
-    
-    classifier->domains[1].domain = strdup("Politică");
-    classifier->domains[1].probability = 1.0/3.0;
-    classifier->domains[1].document_count = 0;
-    classifier->domains[1].word_counts = NULL;
-    classifier->domains[1].word_count_size = 0;
-    
-    classifier->domains[2].domain = strdup("Tehnologie");
-    classifier->domains[2].probability = 1.0/3.0;
-    classifier->domains[2].document_count = 0;
-    classifier->domains[2].word_counts = NULL;
-    classifier->domains[2].word_count_size = 0;
-    
-    return classifier;
+    for (size_t d = 0; d < DOMAINS_COUNT; d++) {
+        int domain = keyword_set_domain(set, domains[d].domain);
+        for (int k = 0; k < domains[d].keywords_count; k++) {
+            if (domain < 0 || keyword_set_add(set, domain, domains[d].keywords[k]) < 0) {
+                keyword_set_destroy(set);
+                return NULL;
+            }
+        }
+    }
+    return set;
 }
 
-void train_bayes_classifier(BayesClassifier* classifier, const char* text, const char* domain) {
-    if (!classifier || !text || !domain) return;
-    
-    int domain_idx = -1;
-    for (int i = 0; i < classifier->count; i++) {
-        if (strcmp(classifier->domains[i].domain, domain) == 0) {
-            domain_idx = i;
-            break;
-        }
+static void build_default_keywords(void) {
+    if (topic_keywords) {
+        return;
     }
     
-    if (domain_idx == -1) {
-        // TODO - more complicated: add new domain if it doesnt exists
-        return;  
+    KeywordSet* set = create_topic_keywords();
+    if (set && keyword_set_build(set) < 0) {
+        keyword_set_destroy(set);
+        set = NULL;
     }
-    
-    classifier->domains[domain_idx].document_count++;
-    classifier->total_documents++;
-    
-    
-    for (int i = 0; i < classifier->count; i++) {
-        classifier->domains[i].probability = 
-            (double)classifier->domains[i].document_count / classifier->total_documents;
+    topic_keywords = set;
+}
+
+static const KeywordSet* get_topic_keywords(void) {
+    pthread_once(&keywords_once, build_default_keywords);
+    return topic_keywords;
+}
+
+int load_topic_keywords(const char* const* paths, int count) {
+    KeywordSet* set = create_topic_keywords();
+    if (!set) {
+        return -1;
     }
     
-    // tokenize text and update word freq
-    TokenizationResult* tokens = tokenize_text(text);
-    if (!tokens) return;
-    
-    for (int i = 0; i < tokens->count; i++) {
-        // add or update word in hash table
-        // Implementare simplif: cautare liniara
-        int found = 0;
-        for (int j = 0; j < classifier->domains[domain_idx].word_count_size; j++) {
-            if (strcmp(classifier->domains[domain_idx].word_counts[j].word, tokens->tokens[i].token) == 0) {
-                classifier->domains[domain_idx].word_counts[j].count += tokens->tokens[i].count;
-                found = 1;
-                break;
-            }
-        }
-        
-        if (!found) {
-            // add new word
-            int new_size = classifier->domains[domain_idx].word_count_size + 1;
-            classifier->domains[domain_idx].word_counts = 
-                realloc(classifier->domains[domain_idx].word_counts, 
-                       new_size * sizeof(*classifier->domains[domain_idx].word_counts));
-            
-            if (!classifier->domains[domain_idx].word_counts) continue;
-            
-            classifier->domains[domain_idx].word_counts[new_size - 1].word = 
-                strdup(tokens->tokens[i].token);
-            classifier->domains[domain_idx].word_counts[new_size - 1].count = 
-                tokens->tokens[i].count;
-            
-            classifier->domains[domain_idx].word_count_size = new_size;
+    for (int i = 0; i < count; i++) {
+        if (keyword_set_load(set, paths[i]) < 0) {
+            keyword_set_destroy(set);
+            return -1;
         }
     }
+    if (keyword_set_build(set) < 0) {
+        keyword_set_destroy(set);
+        return -1;
+    }
     
-    free_tokenization_result(tokens);
+    keyword_set_destroy(topic_keywords);
+    topic_keywords = set;
+    return keyword_set_phrase_count(set);
 }
 
-char* classify_text_bayes(BayesClassifier* classifier, const char* text) {
-    if (!classifier || !text) return strdup("Eroare");
-    
-    TokenizationResult* tokens = tokenize_text(text);
-    if (!tokens) return strdup("Eroare la tokenizare");
-    
-    double max_prob = -1.0;
-    int max_domain = -1;
-    
-    // calculate probability for each domain
-    for (int d = 0; d < classifier->count; d++) {
-        // use log to avoid underflow
-        double prob = log(classifier->domains[d].probability);
-        
-        // for every token we add log(P(token|domain))
-        for (int t = 0; t < tokens->count; t++) {
-            // search for token in domains word counts
-            int found = 0;
-            int token_count = 0;
-            
-            for (int w = 0; w < classifier->domains[d].word_count_size; w++) {
-                if (strcmp(classifier->domains[d].word_counts[w].word, tokens->tokens[t].token) == 0) {
-                    token_count = classifier->domains[d].word_counts[w].count;
-                    found = 1;
-                    break;
-                }
-            }
-            
-            // calculate conditional probability
-            // add 1 to token count if not found (Laplace smoothing)
-            int total_words = 0;
-            for (int w = 0; w < classifier->domains[d].word_count_size; w++) {
-                total_words += classifier->domains[d].word_counts[w].count;
-            }
-            
-            double cond_prob = (found ? token_count + 1.0 : 1.0) / 
-                              (total_words + classifier->domains[d].word_count_size + 1.0);
-            
-            // add log conditional probability to the total probability
-            prob += log(cond_prob) * tokens->tokens[t].count;
-        }
-        
-        // verify if this domain has the highest probability
-        if (prob > max_prob) {
-            max_prob = prob;
-            max_domain = d;
-        }
+
+// O(1) lookup in the perfect-hash table generated from resources/stopwords_*.txt;
+// word must already be lowercase
+static int is_stopword(const char* word, int length, int languages) {
+    if (length > STOPWORD_MAX_LENGTH) {
+        return 0;
     }
     
-    free_tokenization_result(tokens);
+    unsigned int hash = stopword_hash(word, length);
+    unsigned int displacement = stopword_displacements[hash & (STOPWORD_BUCKETS - 1)];
+    const StopwordEntry* entry = &stopword_table[stopword_slot(hash, displacement, STOPWORD_SLOTS - 1)];
     
-    // return the domain with the highest probability
-    if (max_domain >= 0) {
-        return strdup(classifier->domains[max_domain].domain);
-    } else {
-        return strdup("Necunoscut");
-    }
+    return entry->word && entry->length == length && (entry->languages & languages) &&
+           memcmp(entry->word, word, length) == 0;
 }
 
+// FNV-1a
+static unsigned int hash_word(const char* word, int length) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        hash ^= (unsigned char)word[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
 
+#define INITIAL_VOCABULARY_CAPACITY 256
+#define INITIAL_WINDOW_CAPACITY 64
+#define MIN_DEAD_TERMS_TO_COMPACT 1024
 
-int count_words(const char* text) {
-    const char* error;
-    int erroffset;
-    pcre* re;
-    int ovector[30];
-    int count = 0;
-
-    const char* pattern = "\\b[a-zA-Z]+\\b";
-    re = pcre_compile(pattern, 0, &error, &erroffset, NULL);
-    if (!re) {
-        fprintf(stderr, "PCRE compile error: %s\n", error);
+int vocabulary_init(Vocabulary* vocabulary) {
+    vocabulary->count = 0;
+    vocabulary->capacity = INITIAL_VOCABULARY_CAPACITY;
+    vocabulary->words = (char**)malloc(vocabulary->capacity * sizeof(char*));
+    vocabulary->hashes = (unsigned int*)malloc(vocabulary->capacity * sizeof(unsigned int));
+    vocabulary->slot_capacity = INITIAL_VOCABULARY_CAPACITY * 2;
+    vocabulary->slots = (int*)malloc(vocabulary->slot_capacity * sizeof(int));
+    vocabulary->pool = NULL;
+    vocabulary->pool_size = 0;
+    
+    if (!vocabulary->words || !vocabulary->hashes || !vocabulary->slots) {
+        vocabulary_free(vocabulary);
         return -1;
     }
+    
+    for (int i = 0; i < vocabulary->slot_capacity; i++) {
+        vocabulary->slots[i] = -1;
+    }
+    return 0;
+}
 
-    int start = 0;
-    int rc;
-    while ((rc = pcre_exec(re, NULL, text, strlen(text), start, 0, ovector, 30)) >= 0) {
-        count++;
-        start = ovector[1];
+void vocabulary_free(Vocabulary* vocabulary) {
+    if (vocabulary->words) {
+        for (int i = 0; i < vocabulary->count; i++) {
+            const char* word = vocabulary->words[i];
+            if (word < vocabulary->pool || word >= vocabulary->pool + vocabulary->pool_size) {
+                free(vocabulary->words[i]);
+            }
+        }
     }
+    free(vocabulary->words);
+    free(vocabulary->hashes);
+    free(vocabulary->slots);
+    vocabulary->words = NULL;
+    vocabulary->hashes = NULL;
+    vocabulary->slots = NULL;
+    vocabulary->count = 0;
+    vocabulary->capacity = 0;
+    vocabulary->slot_capacity = 0;
+    vocabulary->pool = NULL;
+    vocabulary->pool_size = 0;
+}
 
-    pcre_free(re);
-    return count;
+// slot of word, or of the empty slot where it would be inserted
+static int vocabulary_find_slot(const Vocabulary* vocabulary, const char* word, unsigned int hash) {
+    unsigned int mask = vocabulary->slot_capacity - 1;
+    unsigned int pos = hash & mask;
+    while (vocabulary->slots[pos] >= 0) {
+        int id = vocabulary->slots[pos];
+        if (vocabulary->hashes[id] == hash && strcmp(vocabulary->words[id], word) == 0) {
+            break;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return pos;
 }
 
+int vocabulary_lookup(const Vocabulary* vocabulary, const char* word) {
+    unsigned int hash = hash_word(word, strlen(word));
+    return vocabulary->slots[vocabulary_find_slot(vocabulary, word, hash)];
+}
 
-TokenizationResult* tokenize_text(const char* text) {
-    const char* error;
-    int erroffset;
-    pcre* re;
-    int ovector[30];
-    
-    TokenizationResult* result = (TokenizationResult*)malloc(sizeof(TokenizationResult));
-    if (!result) {
-        return NULL;
+static int vocabulary_grow_slots(Vocabulary* vocabulary) {
+    int new_capacity = vocabulary->slot_capacity * 2;
+    int* new_slots = (int*)malloc(new_capacity * sizeof(int));
+    if (!new_slots) {
+        return -1;
+    }
+    for (int i = 0; i < new_capacity; i++) {
+        new_slots[i] = -1;
     }
     
-    result->capacity = 100;  // initial capacity
-    result->count = 0;
-    result->tokens = (Token*)malloc(result->capacity * sizeof(Token));
-    if (!result->tokens) {
-        free(result);
-        return NULL;
+    unsigned int mask = new_capacity - 1;
+    for (int id = 0; id < vocabulary->count; id++) {
+        unsigned int pos = vocabulary->hashes[id] & mask;
+        while (new_slots[pos] >= 0) {
+            pos = (pos + 1) & mask;
+        }
+        new_slots[pos] = id;
     }
     
-    const char* pattern = "\\b[a-zA-Z]+\\b";
-    re = pcre_compile(pattern, 0, &error, &erroffset, NULL);
-    if (!re) {
-        fprintf(stderr, "PCRE compile error: %s\n", error);
-        free(result->tokens);
-        free(result);
-        return NULL;
+    free(vocabulary->slots);
+    vocabulary->slots = new_slots;
+    vocabulary->slot_capacity = new_capacity;
+    return 0;
+}
+
+int vocabulary_add(Vocabulary* vocabulary, const char* word) {
+    unsigned int hash = hash_word(word, strlen(word));
+    int pos = vocabulary_find_slot(vocabulary, word, hash);
+    if (vocabulary->slots[pos] >= 0) {
+        return vocabulary->slots[pos];
     }
     
-    int start = 0;
-    int rc;
-    char token_buffer[256];
+    // tabela creste inainte de insert, ca un esec sa lase vocabularul
+    // neschimbat (si cel mult pe jumatate plin)
+    if ((vocabulary->count + 1) * 2 > vocabulary->slot_capacity) {
+        if (vocabulary_grow_slots(vocabulary) < 0) {
+            return -1;
+        }
+        pos = vocabulary_find_slot(vocabulary, word, hash);
+    }
     
-    while ((rc = pcre_exec(re, NULL, text, strlen(text), start, 0, ovector, 30)) >= 0) {
-        int token_length = ovector[1] - ovector[0];
-        if (token_length < sizeof(token_buffer)) {
-            strncpy(token_buffer, text + ovector[0], token_length);
-            token_buffer[token_length] = '\0';
-            
-            
-            for (int i = 0; i < token_length; i++) {
-                token_buffer[i] = tolower(token_buffer[i]);
-            }
-            
-            // verify if the token is not a stopword
-            if (!is_stopword(token_buffer)) {
-                // verify if the token already exists in the result
-                int found = 0;
-                for (int i = 0; i < result->count; i++) {
-                    if (strcmp(result->tokens[i].token, token_buffer) == 0) {
-                        result->tokens[i].count++;
-                        found = 1;
-                        break;
-                    }
-                }
-                
-                if (!found) {
-                    // verrify if we need to expand the result array
-                    if (result->count >= result->capacity) {
-                        result->capacity *= 2;
-                        Token* new_tokens = (Token*)realloc(result->tokens, result->capacity * sizeof(Token));
-                        if (!new_tokens) {
-                            for (int i = 0; i < result->count; i++) {
-                                free(result->tokens[i].token);
-                            }
-                            free(result->tokens);
-                            free(result);
-                            pcre_free(re);
-                            return NULL;
-                        }
-                        result->tokens = new_tokens;
-                    }
-                    
-                    result->tokens[result->count].token = strdup(token_buffer);
-                    result->tokens[result->count].count = 1;
-                    result->count++;
-                }
-            }
+    if (vocabulary->count >= vocabulary->capacity) {
+        int new_capacity = vocabulary->capacity * 2;
+        char** new_words = (char**)realloc(vocabulary->words, new_capacity * sizeof(char*));
+        if (!new_words) {
+            return -1;
         }
-        
-        start = ovector[1];
+        vocabulary->words = new_words;
+        unsigned int* new_hashes = (unsigned int*)realloc(vocabulary->hashes, new_capacity * sizeof(unsigned int));
+        if (!new_hashes) {
+            return -1;
+        }
+        vocabulary->hashes = new_hashes;
+        vocabulary->capacity = new_capacity;
     }
     
-    pcre_free(re);
-    return result;
+    char* copy = strdup(word);
+    if (!copy) {
+        return -1;
+    }
+    
+    int id = vocabulary->count++;
+    vocabulary->words[id] = copy;
+    vocabulary->hashes[id] = hash;
+    vocabulary->slots[pos] = id;
+    return id;
 }
 
 
-void free_tokenization_result(TokenizationResult* result) {
-    if (result) {
-        for (int i = 0; i < result->count; i++) {
-            free(result->tokens[i].token);
-        }
-        free(result->tokens);
-        free(result);
+static const char* default_domains[] = {"Sport", "Politică", "Tehnologie"};
+#define DEFAULT_DOMAINS_COUNT (sizeof(default_domains) / sizeof(default_domains[0]))
+
+BayesClassifier* create_bayes_classifier() {
+    BayesClassifier* classifier = (BayesClassifier*)calloc(1, sizeof(BayesClassifier));
+    if (!classifier) return NULL;
+    
+    if (vocabulary_init(&classifier->vocabulary) < 0) {
+        free(classifier);
+        return NULL;
     }
+    return classifier;
 }
 
+// P(domeniu) din documentele vazute; uniforma cat timp nu exista niciunul
+static void update_domain_probabilities(BayesClassifier* classifier) {
+    for (int i = 0; i < classifier->count; i++) {
+        classifier->domains[i].probability = classifier->total_documents > 0 ?
+            (double)classifier->domains[i].document_count / classifier->total_documents :
+            1.0 / classifier->count;
+    }
+}
 
-char* determine_topic(const char* text) {
-    TokenizationResult* tokens = tokenize_text(text);
-    if (!tokens) {
-        return strdup("Eroare la procesare");
+int add_bayes_domain(BayesClassifier* classifier, const char* domain) {
+    for (int i = 0; i < classifier->count; i++) {
+        if (strcmp(classifier->domains[i].domain, domain) == 0) {
+            return i;
+        }
     }
     
-    int domain_scores[DOMAINS_COUNT] = {0};
+    // domeniile se adauga rar: tabloul creste cu cate unul
+    DomainBayes* domains = (DomainBayes*)realloc(classifier->domains,
+                                                 (classifier->count + 1) * sizeof(DomainBayes));
+    if (!domains) return -1;
+    classifier->domains = domains;
     
-    // calculate scores for each domain based on keywords
-    for (int i = 0; i < tokens->count; i++) {
-        for (int d = 0; d < DOMAINS_COUNT; d++) {
-            for (int k = 0; k < domains[d].keywords_count; k++) {
-                if (strcasecmp(tokens->tokens[i].token, domains[d].keywords[k]) == 0) {
-                    domain_scores[d] += tokens->tokens[i].count;
-                }
-            }
-        }
-    }
+    DomainBayes* added = &domains[classifier->count];
+    memset(added, 0, sizeof(DomainBayes));
+    added->domain = strdup(domain);
+    if (!added->domain) return -1;
     
-    int max_score = -1;
-    int max_domain = -1;
+    classifier->count++;
+    update_domain_probabilities(classifier);
+    return classifier->count - 1;
+}
+
+BayesClassifier* init_bayes_classifier() {
+    BayesClassifier* classifier = create_bayes_classifier();
+    if (!classifier) return NULL;
     
-    for (int d = 0; d < DOMAINS_COUNT; d++) {
-        if (domain_scores[d] > max_score) {
-            max_score = domain_scores[d];
-            max_domain = d;
+    for (size_t i = 0; i < DEFAULT_DOMAINS_COUNT; i++) {
+        if (add_bayes_domain(classifier, default_domains[i]) < 0) {
+            free_bayes_classifier(classifier);
+            return NULL;
         }
     }
     
-    char* result;
-    if (max_domain >= 0 && max_score > 0) {
-        result = strdup(domains[max_domain].domain);
-    } else {
-        result = strdup("Necunoscut");
-    }
-    
-    free_tokenization_result(tokens);
-    return result;
+    return classifier;
 }
 
-static Sentence* split_sentences(const char* text, int* count) {
-    const char* error;
-    int erroffset;
-    pcre* re;
-    int ovector[30];
-    
-    const char* pattern = "[^.!?]+[.!?]";
-    re = pcre_compile(pattern, 0, &error, &erroffset, NULL);
-    if (!re) {
-        fprintf(stderr, "PCRE compile error: %s\n", error);
-        return NULL;
+// grows the dense per-domain arrays so that every vocabulary id has a slot
+static int ensure_domain_capacity(DomainBayes* domain, int needed) {
+    if (needed <= domain->capacity) {
+        return 0;
     }
     
-    int sentence_count = 0;
-    int start = 0;
-    int rc;
-    
-    while ((rc = pcre_exec(re, NULL, text, strlen(text), start, 0, ovector, 30)) >= 0) {
-        sentence_count++;
-        start = ovector[1];
+    int new_capacity = domain->capacity ? domain->capacity : INITIAL_VOCABULARY_CAPACITY;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
     }
     
-    if (sentence_count == 0) {
-        pcre_free(re);
-        return NULL;
+    int* new_counts = (int*)realloc(domain->word_counts, new_capacity * sizeof(int));
+    if (!new_counts) {
+        return -1;
     }
+    domain->word_counts = new_counts;
     
-    Sentence* sentences = (Sentence*)malloc(sentence_count * sizeof(Sentence));
-    if (!sentences) {
-        pcre_free(re);
-        return NULL;
+    double* new_logs = (double*)realloc(domain->log_counts, new_capacity * sizeof(double));
+    if (!new_logs) {
+        return -1;
     }
+    domain->log_counts = new_logs;
     
-    start = 0;
-    int index = 0;
-    
-    pcre_extra* study = pcre_study(re, 0, &error);
-    
-    while ((rc = pcre_exec(re, study, text, strlen(text), start, 0, ovector, 30)) >= 0) {
-        int len = ovector[1] - ovector[0];
-        sentences[index].text = (char*)malloc(len + 1);
-        if (sentences[index].text) {
-            strncpy(sentences[index].text, text + ovector[0], len);
-            sentences[index].text[len] = '\0';
-            sentences[index].score = 0.0;
-            index++;
-        }
-        start = ovector[1];
-    }
+    // log(0 + 1) = 0 for words never seen in this domain
+    memset(domain->word_counts + domain->capacity, 0, (new_capacity - domain->capacity) * sizeof(int));
+    memset(domain->log_counts + domain->capacity, 0, (new_capacity - domain->capacity) * sizeof(double));
+    domain->capacity = new_capacity;
+    return 0;
+}
+
+void train_bayes_classifier(BayesClassifier* classifier, const char* text, const char* domain) {
+    if (!classifier || !text || !domain) return;
     
-    if (study) pcre_free(study);
-    pcre_free(re);
+    TokenizationResult* tokens = tokenize_text(text);
+    if (!tokens) return;
     
-    *count = index;
-    return sentences;
+    train_bayes_classifier_tokens(classifier, tokens, domain);
+    free_tokenization_result(tokens);
 }
 
-static void score_sentences(Sentence* sentences, int sentence_count, TokenizationResult* tokens) {
+// tokens[0..count): cuvintele documentului, fiecare o singura data.
+// Un domeniu nou (de ex. din --keywords) se adauga modelului.
+static void train_token_counts(BayesClassifier* classifier, const Token* tokens, int count, const char* domain) {
+    int domain_idx = add_bayes_domain(classifier, domain);
+    if (domain_idx < 0) {
+        return;
+    }
     
-    for (int i = 0; i < sentence_count; i++) {
-        for (int j = 0; j < tokens->count; j++) {
-            
-            char* found = strcasestr(sentences[i].text, tokens->tokens[j].token);
-            if (found) {
-                
-                sentences[i].score += tokens->tokens[j].count;
-            }
-        }
+    classifier->domains[domain_idx].document_count++;
+    classifier->total_documents++;
+    update_domain_probabilities(classifier);
+    
+    // update word freq: shared vocabulary id -> dense per-domain counters
+    DomainBayes* target = &classifier->domains[domain_idx];
+    for (int i = 0; i < count; i++) {
+        int id = vocabulary_add(&classifier->vocabulary, tokens[i].token);
+        if (id < 0 || ensure_domain_capacity(target, id + 1) < 0) continue;
         
-        int length = count_words(sentences[i].text);
-        if (length > 0) {
-            sentences[i].score /= length;
+        if (target->word_counts[id] == 0) {
+            target->word_count_size++;
         }
+        target->word_counts[id] += tokens[i].count;
+        target->total_words += tokens[i].count;
+        target->log_counts[id] = log(target->word_counts[id] + 1.0);
     }
 }
 
-void calculate_tf_idf(TokenizationResult* result, DocumentCollection* collection) {
-    int doc_length = 0;
+void train_bayes_classifier_tokens(BayesClassifier* classifier, TokenizationResult* tokens, const char* domain) {
+    if (!classifier || !tokens || !domain) return;
     
-    for (int i = 0; i < result->count; i++) {
-        doc_length += result->tokens[i].count;
+    train_token_counts(classifier, tokens->tokens, tokens->count, domain);
+}
+
+static TrainingExample* build_training_example(const Token* tokens, int count, const char* domain) {
+    size_t domain_size = strlen(domain) + 1;
+    size_t size = sizeof(TrainingExample) + count * sizeof(Token) + domain_size;
+    for (int i = 0; i < count; i++) {
+        size += strlen(tokens[i].token) + 1;
     }
     
-    for (int i = 0; i < result->count; i++) {
-        result->tokens[i].tf = (double)result->tokens[i].count / doc_length;
-    }
+    TrainingExample* example = (TrainingExample*)malloc(size);
+    if (!example) return NULL;
     
-    // calculate IDF for each token
-    for (int i = 0; i < result->count; i++) {
-        int doc_with_term = 0;
-        
-        for (int j = 0; j < collection->document_count; j++) {
-            if (strcasestr(collection->documents[j], result->tokens[i].token) != NULL) {
-                doc_with_term++;
-            }
-        }
+    // [TrainingExample][Token x count][domeniu\0][cuvinte\0...]
+    example->tokens = (Token*)(example + 1);
+    example->count = count;
+    example->size = size;
+    example->domain = (char*)(example->tokens + count);
+    memcpy(example->domain, domain, domain_size);
     
-        result->tokens[i].idf = log((double)(collection->document_count + 1) / (doc_with_term + 1));
-        
-        result->tokens[i].tf_idf = result->tokens[i].tf * result->tokens[i].idf;
+    char* text = example->domain + domain_size;
+    for (int i = 0; i < count; i++) {
+        size_t length = strlen(tokens[i].token) + 1;
+        memcpy(text, tokens[i].token, length);
+        example->tokens[i] = tokens[i];
+        example->tokens[i].token = text;
+        text += length;
     }
+    return example;
 }
 
+TrainingExample* create_training_example(TokenizationResult* tokens, const char* domain) {
+    return build_training_example(tokens->tokens, tokens->count, domain);
+}
 
+TrainingExample* copy_training_example(const TrainingExample* example) {
+    return build_training_example(example->tokens, example->count, example->domain);
+}
 
-char* generate_summary(const char* text, int max_sentences, DocumentCollection* collection) {
-    TokenizationResult* tokens = tokenize_text(text);
-    if (!tokens) {
-        return strdup("Eroare la procesare text.");
-    }
+void train_bayes_classifier_example(BayesClassifier* classifier, const TrainingExample* example) {
+    if (!classifier || !example) return;
     
-    calculate_tf_idf(tokens, collection);
+    train_token_counts(classifier, example->tokens, example->count, example->domain);
+}
+
+int merge_bayes_classifier(BayesClassifier* into, const BayesClassifier* from) {
+    const Vocabulary* words = &from->vocabulary;
+    int* ids = (int*)malloc((words->count ? words->count : 1) * sizeof(int));
+    if (!ids) return -1;
     
-    int sentence_count = 0;
-    Sentence* sentences = split_sentences(text, &sentence_count);
-    if (!sentences) {
-        free_tokenization_result(tokens);
-        return strdup("Eroare la împărțirea textului în propoziții.");
+    // id din from -> id din into
+    for (int i = 0; i < words->count; i++) {
+        ids[i] = vocabulary_add(&into->vocabulary, words->words[i]);
+        if (ids[i] < 0) {
+            free(ids);
+            return -1;
+        }
     }
     
-    for (int i = 0; i < sentence_count; i++) {
-        sentences[i].score = 0.0;
-        
-        for (int j = 0; j < tokens->count; j++) {
-        
-            if (strcasestr(sentences[i].text, tokens->tokens[j].token)) {
-                
-                sentences[i].score += tokens->tokens[j].tf_idf;
-            }
-        }
-        
-        
-        int length = count_words(sentences[i].text);
-        if (length > 0) {
-            sentences[i].score /= length;
+    for (int d = 0; d < from->count; d++) {
+        const DomainBayes* source = &from->domains[d];
+        int index = add_bayes_domain(into, source->domain);
+        if (index < 0 || ensure_domain_capacity(&into->domains[index], into->vocabulary.count) < 0) {
+            free(ids);
+            return -1;
         }
         
-        if (i == 0 || i == sentence_count - 1) {
-            sentences[i].score *= 1.5; 
-        }
-    }
-    
-    
-    for (int i = 0; i < sentence_count - 1; i++) {
-        for (int j = i + 1; j < sentence_count; j++) {
-            if (sentences[j].score > sentences[i].score) {
-                Sentence temp = sentences[i];
-                sentences[i] = sentences[j];
-                sentences[j] = temp;
+        DomainBayes* target = &into->domains[index];
+        int limit = source->capacity < words->count ? source->capacity : words->count;
+        for (int i = 0; i < limit; i++) {
+            int count = source->word_counts[i];
+            if (count == 0) continue;
+            
+            int id = ids[i];
+            if (target->word_counts[id] == 0) {
+                target->word_count_size++;
             }
+            target->word_counts[id] += count;
+            target->log_counts[id] = log(target->word_counts[id] + 1.0);
         }
+        target->total_words += source->total_words;
+        target->document_count += source->document_count;
     }
     
+    into->total_documents += from->total_documents;
+    update_domain_probabilities(into);
+    free(ids);
+    return 0;
+}
+
+char* classify_text_bayes(BayesClassifier* classifier, const char* text) {
+    if (!classifier || !text) return strdup("Eroare");
     
-    int summary_length = (max_sentences < sentence_count) ? max_sentences : sentence_count;
-    if (summary_length <= 0) {
-        summary_length = 1;  
+    TokenizationResult* tokens = tokenize_text(text);
+    if (!tokens) return strdup("Eroare la tokenizare");
+    
+    char* result = classify_tokens_bayes(classifier, tokens);
+    free_tokenization_result(tokens);
+    return result;
+}
+
+char* classify_tokens_bayes(BayesClassifier* classifier, TokenizationResult* tokens) {
+    if (!classifier || !tokens) return strdup("Eroare");
+    
+    // fara documente de antrenare scorurile ar fi doar probabilitatile egale
+    if (classifier->total_documents == 0) {
+        return strdup("Necunoscut");
+    }
+    
+    double scores[classifier->count];
+    double log_denominators[classifier->count];
+    int known = 0;
+    
+    // use log to avoid underflow
+    for (int d = 0; d < classifier->count; d++) {
+        scores[d] = log(classifier->domains[d].probability);
+        log_denominators[d] = log(classifier->domains[d].total_words + classifier->vocabulary.count + 0.0);
+    }
+    
+    // for every token we add log(P(token|domain)) for each domain:
+    // one vocabulary lookup per token, then one array read per domain
+    // (Laplace smoothing: (count + 1) / (total_words + vocabulary size));
+    // words outside the vocabulary were never seen in training and are skipped
+    for (int t = 0; t < tokens->count; t++) {
+        int id = vocabulary_lookup(&classifier->vocabulary, tokens->tokens[t].token);
+        int count = tokens->tokens[t].count;
+        known |= id >= 0;
+        if (id < 0) continue;
+        
+        for (int d = 0; d < classifier->count; d++) {
+            DomainBayes* domain = &classifier->domains[d];
+            double log_numerator = id < domain->capacity ? domain->log_counts[id] : 0.0;
+            scores[d] += (log_numerator - log_denominators[d]) * count;
+        }
+    }
+    
+    // niciun cuvant cunoscut: ar decide doar probabilitatea initiala
+    if (!known) {
+        return strdup("Necunoscut");
+    }
+    
+    // scorurile sunt sume de logaritmi, deci aproape mereu sub -1
+    double max_prob = -INFINITY;
+    int max_domain = -1;
+    
+    // verify which domain has the highest probability
+    for (int d = 0; d < classifier->count; d++) {
+        if (scores[d] > max_prob) {
+            max_prob = scores[d];
+            max_domain = d;
+        }
+    }
+    
+    // return the domain with the highest probability
+    if (max_domain >= 0) {
+        return strdup(classifier->domains[max_domain].domain);
+    } else {
+        return strdup("Necunoscut");
+    }
+}
+
+void free_bayes_classifier(BayesClassifier* classifier) {
+    if (!classifier) return;
+    
+    for (int i = 0; i < classifier->count; i++) {
+        free(classifier->domains[i].domain);
+        free(classifier->domains[i].word_counts);
+        free(classifier->domains[i].log_counts);
+    }
+    free(classifier->domains);
+    vocabulary_free(&classifier->vocabulary);
+    if (classifier->snapshot) {
+        munmap(classifier->snapshot, classifier->snapshot_size);
+    }
+    free(classifier);
+}
+
+
+
+// aceleasi cuvinte ca next_token, numarate fara tokenizare (vezi word_count.c)
+int count_words(const char* text) {
+    return (int)count_word_runs(text, strlen(text));
+}
+
+
+// Arena: lista de blocuri; current e blocul in care se aloca acum.
+// Blocurile de dupa current sunt refolosite dupa arena_reset.
+#define ARENA_ALIGNMENT 16
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t size;
+    size_t used;
+    _Alignas(ARENA_ALIGNMENT) char data[];
+} ArenaBlock;
+
+struct Arena {
+    ArenaBlock* first;
+    ArenaBlock* current;
+    size_t block_size;
+};
+
+static ArenaBlock* create_arena_block(size_t size) {
+    ArenaBlock* block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + size);
+    if (block) {
+        block->next = NULL;
+        block->size = size;
+        block->used = 0;
+    }
+    return block;
+}
+
+Arena* arena_create(size_t block_size) {
+    Arena* arena = (Arena*)malloc(sizeof(Arena));
+    if (!arena) {
+        return NULL;
+    }
+    
+    arena->block_size = block_size;
+    arena->first = create_arena_block(block_size);
+    if (!arena->first) {
+        free(arena);
+        return NULL;
+    }
+    arena->current = arena->first;
+    return arena;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    ArenaBlock* block = arena->current;
+    
+    while (block->used + size > block->size) {
+        ArenaBlock* next = block->next;
+        if (!next || next->size < size) {
+            // bloc nou intre current si restul listei
+            next = create_arena_block(size > arena->block_size ? size : arena->block_size);
+            if (!next) {
+                return NULL;
+            }
+            next->next = block->next;
+            block->next = next;
+        }
+        next->used = 0;
+        block = next;
+    }
+    
+    arena->current = block;
+    void* pointer = block->data + block->used;
+    block->used += size;
+    return pointer;
+}
+
+void arena_reset(Arena* arena) {
+    arena->current = arena->first;
+    arena->first->used = 0;
+}
+
+void arena_destroy(Arena* arena) {
+    if (!arena) return;
+    
+    ArenaBlock* block = arena->first;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+// Memoria temporara a tokenizarii/analizei: din arena, daca exista, altfel malloc
+static void* scratch_alloc(Arena* arena, size_t size) {
+    return arena ? arena_alloc(arena, size) : malloc(size);
+}
+
+static void* scratch_grow(Arena* arena, void* pointer, size_t old_size, size_t new_size) {
+    if (!arena) {
+        return realloc(pointer, new_size);
+    }
+    
+    void* grown = arena_alloc(arena, new_size);
+    if (grown && pointer) {
+        memcpy(grown, pointer, old_size);
+    }
+    return grown;
+}
+
+static void scratch_free(Arena* arena, void* pointer) {
+    if (!arena) {
+        free(pointer);
+    }
+}
+
+
+#define INITIAL_TOKEN_CAPACITY 100
+#define INITIAL_SLOT_CAPACITY 256
+
+static TokenSlot* alloc_slots(Arena* arena, int slot_capacity) {
+    TokenSlot* slots = (TokenSlot*)scratch_alloc(arena, slot_capacity * sizeof(TokenSlot));
+    if (slots) {
+        for (int i = 0; i < slot_capacity; i++) {
+            slots[i].index = -1;
+        }
+    }
+    return slots;
+}
+
+static TokenizationResult* create_tokenization_result(Arena* arena) {
+    const KeywordSet* keywords = get_topic_keywords();
+    if (!keywords) {
+        return NULL;
+    }
+    
+    TokenizationResult* result = (TokenizationResult*)scratch_alloc(arena, sizeof(TokenizationResult));
+    if (!result) {
+        return NULL;
+    }
+    
+    int domain_count = keyword_set_domain_count(keywords);
+    result->arena = arena;
+    result->capacity = INITIAL_TOKEN_CAPACITY;
+    result->count = 0;
+    result->tokens = (Token*)scratch_alloc(arena, result->capacity * sizeof(Token));
+    result->slot_capacity = INITIAL_SLOT_CAPACITY;
+    result->slots = alloc_slots(arena, result->slot_capacity);
+    result->keywords = keywords;
+    result->keyword_state = keyword_set_start(keywords);
+    result->topic_scores = (int*)scratch_alloc(arena, (domain_count > 0 ? domain_count : 1) * sizeof(int));
+    if (!result->tokens || !result->slots || !result->topic_scores) {
+        scratch_free(arena, result->tokens);
+        scratch_free(arena, result->slots);
+        scratch_free(arena, result->topic_scores);
+        scratch_free(arena, result);
+        return NULL;
+    }
+    memset(result->topic_scores, 0, domain_count * sizeof(int));
+    
+    return result;
+}
+
+// keyword phrases do not span sentences
+static void end_keyword_phrase(TokenizationResult* result) {
+    result->keyword_state = keyword_set_start(result->keywords);
+}
+
+// doubles the slot table and reinserts every token using the cached hashes
+static int grow_slots(TokenizationResult* result) {
+    int new_capacity = result->slot_capacity * 2;
+    TokenSlot* new_slots = alloc_slots(result->arena, new_capacity);
+    if (!new_slots) {
+        return -1;
+    }
+    
+    unsigned int mask = new_capacity - 1;
+    for (int i = 0; i < result->slot_capacity; i++) {
+        if (result->slots[i].index < 0) continue;
+        unsigned int pos = result->slots[i].hash & mask;
+        while (new_slots[pos].index >= 0) {
+            pos = (pos + 1) & mask;
+        }
+        new_slots[pos] = result->slots[i];
+    }
+    
+    scratch_free(result->arena, result->slots);
+    result->slots = new_slots;
+    result->slot_capacity = new_capacity;
+    return 0;
+}
+
+// adds one occurrence of text[0..length) to the result; *index (if given)
+// is the token's position in tokens[], or -1 for skipped words (stopwords, too long)
+// returns -1 only on allocation failure
+static int add_token(TokenizationResult* result, const char* word, int length, int* index) {
+    char token_buffer[256];
+    
+    if (index) {
+        *index = -1;
+    }
+    
+    if ((size_t)length >= sizeof(token_buffer)) {
+        end_keyword_phrase(result);
+        return 0;
+    }
+    
+    // folded in place; the stopword table keeps the diacritics,
+    // so they are stripped only after the lookup
+    memcpy(token_buffer, word, length);
+    length = fold_word(token_buffer, length, 0);
+    token_buffer[length] = '\0';
+    
+    int stopword = is_stopword(token_buffer, length, STOPWORDS_ALL);
+    
+    if (strip_diacritics) {
+        length = fold_word(token_buffer, length, 1);
+        token_buffer[length] = '\0';
+    }
+    
+    result->keyword_state = keyword_set_feed(result->keywords, result->keyword_state,
+                                             token_buffer, length, result->topic_scores);
+    
+    // verify if the token is not a stopword
+    if (stopword) {
+        return 0;
+    }
+    
+    // verify if the token already exists in the result (linear probing)
+    unsigned int hash = hash_word(token_buffer, length);
+    unsigned int mask = result->slot_capacity - 1;
+    unsigned int pos = hash & mask;
+    while (result->slots[pos].index >= 0) {
+        if (result->slots[pos].hash == hash &&
+            strcmp(result->tokens[result->slots[pos].index].token, token_buffer) == 0) {
+            result->tokens[result->slots[pos].index].count++;
+            if (index) {
+                *index = result->slots[pos].index;
+            }
+            return 0;
+        }
+        pos = (pos + 1) & mask;
+    }
+    
+    // verrify if we need to expand the result array
+    if (result->count >= result->capacity) {
+        int new_capacity = result->capacity * 2;
+        Token* new_tokens = (Token*)scratch_grow(result->arena, result->tokens,
+                                                 result->capacity * sizeof(Token),
+                                                 new_capacity * sizeof(Token));
+        if (!new_tokens) {
+            return -1;
+        }
+        result->tokens = new_tokens;
+        result->capacity = new_capacity;
+    }
+    
+    char* copy = (char*)scratch_alloc(result->arena, length + 1);
+    if (!copy) {
+        return -1;
+    }
+    memcpy(copy, token_buffer, length + 1);
+    result->tokens[result->count].token = copy;
+    result->tokens[result->count].count = 1;
+    result->slots[pos].index = result->count;
+    result->slots[pos].hash = hash;
+    if (index) {
+        *index = result->count;
+    }
+    result->count++;
+    
+    if (result->count * 2 > result->slot_capacity && grow_slots(result) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+
+TokenizationResult* tokenize_text(const char* text) {
+    return tokenize_text_arena(text, NULL);
+}
+
+TokenizationResult* tokenize_text_arena(const char* text, Arena* arena) {
+    TokenizationResult* result = create_tokenization_result(arena);
+    if (!result) {
+        return NULL;
+    }
+    
+    size_t length = strlen(text);
+    size_t pos = 0;
+    size_t start;
+    TokenKind kind;
+    
+    while ((kind = next_token(text, length, &pos, &start, 1)) != TOKEN_NONE) {
+        if (kind == TOKEN_TERMINATOR) {
+            end_keyword_phrase(result);
+        } else if (add_token(result, text + start, pos - start, NULL) < 0) {
+            free_tokenization_result(result);
+            return NULL;
+        }
+    }
+    
+    return result;
+}
+
+
+void free_tokenization_result(TokenizationResult* result) {
+    if (result && !result->arena) {
+        for (int i = 0; i < result->count; i++) {
+            free(result->tokens[i].token);
+        }
+        free(result->tokens);
+        free(result->slots);
+        free(result->topic_scores);
+        free(result);
+    }
+}
+
+
+// analyze_text state that does not outlive the pass
+typedef struct {
+    int sentence_capacity;
+    int term_capacity;
+    int* seen;              // token -> 1 + last sentence that contains it
+    int seen_capacity;
+} AnalysisBuilder;
+
+// the sentence owns the postings added since term_start
+static int add_sentence_span(TextAnalysis* analysis, AnalysisBuilder* builder, int offset, int length,
+                             int word_count, int term_start) {
+    if (analysis->sentence_count >= builder->sentence_capacity) {
+        int new_capacity = builder->sentence_capacity ? builder->sentence_capacity * 2 : 16;
+        SentenceSpan* new_spans = (SentenceSpan*)scratch_grow(analysis->arena, analysis->sentences,
+                                                              builder->sentence_capacity * sizeof(SentenceSpan),
+                                                              new_capacity * sizeof(SentenceSpan));
+        if (!new_spans) {
+            return -1;
+        }
+        analysis->sentences = new_spans;
+        builder->sentence_capacity = new_capacity;
+    }
+    
+    SentenceSpan* span = &analysis->sentences[analysis->sentence_count++];
+    span->offset = offset;
+    span->length = length;
+    span->word_count = word_count;
+    span->term_start = term_start;
+    span->term_count = analysis->term_count - term_start;
+    return 0;
+}
+
+// Sentence text[boundary..end), without surrounding whitespace. A terminator
+// with no text before it is not a sentence: right after a sentence it
+// extends it ("?!", "..."), otherwise it is dropped.
+static int end_sentence_span(TextAnalysis* analysis, AnalysisBuilder* builder, const char* text,
+                             size_t boundary, size_t end, int word_count, int term_start) {
+    size_t first = boundary;
+    while (first < end && (char_class[(unsigned char)text[first]] & CHAR_SPACE)) {
+        first++;
+    }
+    while (end > first && (char_class[(unsigned char)text[end - 1]] & CHAR_SPACE)) {
+        end--;
+    }
+    
+    int terminator = end > first && (char_class[(unsigned char)text[end - 1]] & CHAR_TERMINATOR);
+    if (end == first || (terminator && end - 1 == first)) {
+        if (terminator && analysis->sentence_count > 0) {
+            SentenceSpan* last = &analysis->sentences[analysis->sentence_count - 1];
+            if ((size_t)(last->offset + last->length) == boundary && first == boundary) {
+                last->length++;
+            }
+        }
+        return 0;
+    }
+    return add_sentence_span(analysis, builder, first, end - first, word_count, term_start);
+}
+
+// posting for token index in the current sentence, once per sentence
+static int add_posting(TextAnalysis* analysis, AnalysisBuilder* builder, int index) {
+    if (index >= builder->seen_capacity) {
+        int capacity = builder->seen_capacity ? builder->seen_capacity : INITIAL_TOKEN_CAPACITY;
+        while (capacity <= index) {
+            capacity *= 2;
+        }
+        int* seen = (int*)scratch_grow(analysis->arena, builder->seen, builder->seen_capacity * sizeof(int),
+                                       capacity * sizeof(int));
+        if (!seen) {
+            return -1;
+        }
+        memset(seen + builder->seen_capacity, 0, (capacity - builder->seen_capacity) * sizeof(int));
+        builder->seen = seen;
+        builder->seen_capacity = capacity;
+    }
+    
+    int mark = analysis->sentence_count + 1;
+    if (builder->seen[index] == mark) {
+        return 0;
+    }
+    builder->seen[index] = mark;
+    
+    if (analysis->term_count >= builder->term_capacity) {
+        int capacity = builder->term_capacity ? builder->term_capacity * 2 : 64;
+        int* terms = (int*)scratch_grow(analysis->arena, analysis->terms, builder->term_capacity * sizeof(int),
+                                        capacity * sizeof(int));
+        if (!terms) {
+            return -1;
+        }
+        analysis->terms = terms;
+        builder->term_capacity = capacity;
+    }
+    analysis->terms[analysis->term_count++] = index;
+    return 0;
+}
+
+TextAnalysis* analyze_text(const char* text) {
+    return analyze_text_arena(text, NULL);
+}
+
+TextAnalysis* analyze_text_arena(const char* text, Arena* arena) {
+    if (!text) {
+        return NULL;
+    }
+    
+    TextAnalysis* analysis = (TextAnalysis*)scratch_alloc(arena, sizeof(TextAnalysis));
+    if (!analysis) {
+        return NULL;
+    }
+    memset(analysis, 0, sizeof(TextAnalysis));
+    analysis->arena = arena;
+    
+    analysis->tokens = create_tokenization_result(arena);
+    if (!analysis->tokens) {
+        scratch_free(arena, analysis);
+        return NULL;
+    }
+    
+    size_t length = strlen(text);
+    size_t pos = 0;
+    size_t start;
+    AnalysisBuilder builder = {0};
+    size_t boundary = 0;    // just after the last sentence end
+    int sentence_words = 0;
+    int sentence_terms = 0;
+    int index;
+    TokenKind kind;
+    
+    // one token is either a word or a sentence terminator
+    while ((kind = next_token(text, length, &pos, &start, 1)) != TOKEN_NONE) {
+        if (kind == TOKEN_TERMINATOR) {
+            if (!ends_sentence(text, length, start)) {
+                continue;
+            }
+            end_keyword_phrase(analysis->tokens);
+            if (end_sentence_span(analysis, &builder, text, boundary, pos, sentence_words, sentence_terms) < 0) {
+                goto fail;
+            }
+            boundary = pos;
+            sentence_words = 0;
+            sentence_terms = analysis->term_count;
+        } else {
+            analysis->word_count++;
+            sentence_words++;
+            if (add_token(analysis->tokens, text + start, pos - start, &index) < 0 ||
+                (index >= 0 && add_posting(analysis, &builder, index) < 0)) {
+                goto fail;
+            }
+        }
+    }
+    
+    // text after the last terminator is the last sentence
+    if (end_sentence_span(analysis, &builder, text, boundary, length, sentence_words, sentence_terms) < 0) {
+        goto fail;
+    }
+    scratch_free(arena, builder.seen);
+    return analysis;
+    
+fail:
+    scratch_free(arena, builder.seen);
+    free_text_analysis(analysis);
+    return NULL;
+}
+
+void free_text_analysis(TextAnalysis* analysis) {
+    if (analysis && !analysis->arena) {
+        free_tokenization_result(analysis->tokens);
+        free(analysis->sentences);
+        free(analysis->terms);
+        free(analysis);
+    }
+}
+
+
+char* determine_topic(const char* text) {
+    TokenizationResult* tokens = tokenize_text(text);
+    if (!tokens) {
+        return strdup("Eroare la procesare");
+    }
+    
+    char* result = determine_topic_tokens(tokens);
+    free_tokenization_result(tokens);
+    return result;
+}
+
+// the keyword scores were collected while tokenizing
+char* determine_topic_tokens(TokenizationResult* tokens) {
+    if (!tokens) {
+        return strdup("Eroare la procesare");
+    }
+    
+    int max_score = -1;
+    int max_domain = -1;
+    
+    for (int d = 0; d < keyword_set_domain_count(tokens->keywords); d++) {
+        if (tokens->topic_scores[d] > max_score) {
+            max_score = tokens->topic_scores[d];
+            max_domain = d;
+        }
+    }
+    
+    char* result;
+    if (max_domain >= 0 && max_score > 0) {
+        result = strdup(keyword_set_domain_name(tokens->keywords, max_domain));
+    } else {
+        result = strdup("Necunoscut");
+    }
+    
+    return result;
+}
+
+// the sentence spans found by analyze_text, pointing into text
+static Sentence* split_sentences(const char* text, TextAnalysis* analysis, int* count) {
+    if (analysis->sentence_count == 0) {
+        return NULL;
+    }
+    
+    Sentence* sentences = (Sentence*)scratch_alloc(analysis->arena, analysis->sentence_count * sizeof(Sentence));
+    if (!sentences) {
+        return NULL;
+    }
+    
+    for (int i = 0; i < analysis->sentence_count; i++) {
+        SentenceSpan* span = &analysis->sentences[i];
+        sentences[i].text = text + span->offset;
+        sentences[i].offset = span->offset;
+        sentences[i].length = span->length;
+        sentences[i].score = 0.0;
+        sentences[i].word_count = span->word_count;
+        sentences[i].terms = analysis->terms + span->term_start;
+        sentences[i].term_count = span->term_count;
+    }
+    
+    *count = analysis->sentence_count;
+    return sentences;
+}
+
+// the lower score ranks lower; on ties the later sentence does
+static int ranks_below(const Sentence* a, const Sentence* b) {
+    if (a->score != b->score) {
+        return a->score < b->score;
+    }
+    return a->offset > b->offset;
+}
+
+// min-heap: heap[0] is the weakest of the selected sentences
+static void sift_down(Sentence** heap, int count, int i) {
+    for (;;) {
+        int weakest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < count && ranks_below(heap[left], heap[weakest])) {
+            weakest = left;
+        }
+        if (right < count && ranks_below(heap[right], heap[weakest])) {
+            weakest = right;
+        }
+        if (weakest == i) {
+            return;
+        }
+        Sentence* temp = heap[i];
+        heap[i] = heap[weakest];
+        heap[weakest] = temp;
+        i = weakest;
+    }
+}
+
+// the k best sentences, in O(n log k)
+static void select_top_sentences(Sentence* sentences, int count, Sentence** heap, int k) {
+    for (int i = 0; i < k; i++) {
+        heap[i] = &sentences[i];
+    }
+    for (int i = k / 2 - 1; i >= 0; i--) {
+        sift_down(heap, k, i);
+    }
+    for (int i = k; i < count; i++) {
+        if (ranks_below(heap[0], &sentences[i])) {
+            heap[0] = &sentences[i];
+            sift_down(heap, k, 0);
+        }
+    }
+}
+
+static int compare_sentence_offset(const void* a, const void* b) {
+    const Sentence* first = *(const Sentence* const*)a;
+    const Sentence* second = *(const Sentence* const*)b;
+    return first->offset - second->offset;
+}
+
+void calculate_tf_idf(TokenizationResult* result, DocumentCollection* collection) {
+    int doc_length = 0;
+    
+    for (int i = 0; i < result->count; i++) {
+        doc_length += result->tokens[i].count;
+    }
+    
+    for (int i = 0; i < result->count; i++) {
+        result->tokens[i].tf = (double)result->tokens[i].count / doc_length;
+    }
+    
+    // calculate IDF for each token: one lookup in the document-frequency index
+    for (int i = 0; i < result->count; i++) {
+        int doc_with_term = 0;
+        
+        int id = vocabulary_lookup(&collection->terms, result->tokens[i].token);
+        if (id >= 0) {
+            doc_with_term = collection->document_frequency[id];
+        }
+    
+        result->tokens[i].idf = log((double)(collection->document_count + 1) / (doc_with_term + 1));
+        
+        result->tokens[i].tf_idf = result->tokens[i].tf * result->tokens[i].idf;
+    }
+}
+
+DocumentCollection* create_document_collection(void) {
+    DocumentCollection* collection = (DocumentCollection*)calloc(1, sizeof(DocumentCollection));
+    if (!collection) {
+        return NULL;
+    }
+    
+    if (vocabulary_init(&collection->terms) < 0) {
+        free(collection);
+        return NULL;
+    }
+    return collection;
+}
+
+void set_collection_limits(DocumentCollection* collection, int max_documents, size_t max_bytes, int max_age) {
+    collection->max_documents = max_documents;
+    collection->max_bytes = max_bytes;
+    collection->max_age = max_age;
+    enforce_collection_limits(collection, time(NULL));
+}
+
+// removes the oldest document from the window and its document frequencies
+static void evict_oldest_document(DocumentCollection* collection) {
+    CorpusDocument* doc = &collection->window[collection->window_start];
+    
+    for (int i = 0; i < doc->term_count; i++) {
+        if (--collection->document_frequency[doc->term_ids[i]] == 0) {
+            collection->live_terms--;
+        }
+    }
+    
+    collection->bytes -= doc->bytes;
+    free(doc->term_ids);
+    doc->term_ids = NULL;
+    
+    collection->window_start = (collection->window_start + 1) % collection->window_capacity;
+    collection->document_count--;
+}
+
+// rebuilds the term vocabulary without the terms no document in the window
+// contains anymore, so evicted vocabulary does not accumulate
+static int compact_terms(DocumentCollection* collection) {
+    Vocabulary fresh;
+    if (vocabulary_init(&fresh) < 0) {
+        return -1;
+    }
+    
+    int old_count = collection->terms.count;
+    int* remap = (int*)malloc(old_count * sizeof(int));
+    int* frequency = (int*)calloc(collection->live_terms > 0 ? collection->live_terms : 1, sizeof(int));
+    if (!remap || !frequency) {
+        free(remap);
+        free(frequency);
+        vocabulary_free(&fresh);
+        return -1;
+    }
+    
+    for (int id = 0; id < old_count; id++) {
+        remap[id] = -1;
+        if (collection->document_frequency[id] > 0) {
+            int new_id = vocabulary_add(&fresh, collection->terms.words[id]);
+            if (new_id < 0) {
+                free(remap);
+                free(frequency);
+                vocabulary_free(&fresh);
+                return -1;
+            }
+            remap[id] = new_id;
+            frequency[new_id] = collection->document_frequency[id];
+        }
+    }
+    
+    for (int i = 0; i < collection->document_count; i++) {
+        CorpusDocument* doc = &collection->window[(collection->window_start + i) % collection->window_capacity];
+        for (int t = 0; t < doc->term_count; t++) {
+            doc->term_ids[t] = remap[doc->term_ids[t]];
+        }
+    }
+    
+    vocabulary_free(&collection->terms);
+    free(collection->document_frequency);
+    free(remap);
+    collection->terms = fresh;
+    collection->document_frequency = frequency;
+    collection->frequency_capacity = collection->live_terms > 0 ? collection->live_terms : 1;
+    return 0;
+}
+
+void enforce_collection_limits(DocumentCollection* collection, time_t now) {
+    // FIFO: the newest document always stays, even if it alone exceeds the byte budget
+    while (collection->document_count > 1 &&
+           ((collection->max_documents > 0 && collection->document_count > collection->max_documents) ||
+            (collection->max_bytes > 0 && collection->bytes > collection->max_bytes))) {
+        evict_oldest_document(collection);
+    }
+    
+    // time window
+    while (collection->document_count > 0 && collection->max_age > 0 &&
+           now - collection->window[collection->window_start].added_at > collection->max_age) {
+        evict_oldest_document(collection);
+    }
+    
+    int dead_terms = collection->terms.count - collection->live_terms;
+    if (dead_terms > MIN_DEAD_TERMS_TO_COMPACT && dead_terms > collection->live_terms) {
+        compact_terms(collection);
+    }
+}
+
+static int ensure_window_capacity(DocumentCollection* collection) {
+    if (collection->document_count < collection->window_capacity) {
+        return 0;
     }
     
-    Sentence selected[summary_length];
-    for (int i = 0; i < summary_length; i++) {
-        selected[i] = sentences[i];
+    int new_capacity = collection->window_capacity ? collection->window_capacity * 2 : INITIAL_WINDOW_CAPACITY;
+    CorpusDocument* new_window = (CorpusDocument*)malloc(new_capacity * sizeof(CorpusDocument));
+    if (!new_window) {
+        return -1;
+    }
+    
+    // unroll the circular buffer
+    for (int i = 0; i < collection->document_count; i++) {
+        new_window[i] = collection->window[(collection->window_start + i) % collection->window_capacity];
     }
     
-    for (int i = 0; i < summary_length - 1; i++) {
-        for (int j = i + 1; j < summary_length; j++) {
+    free(collection->window);
+    collection->window = new_window;
+    collection->window_capacity = new_capacity;
+    collection->window_start = 0;
+    return 0;
+}
 
-            const char* pos_i = strstr(text, selected[i].text);
-            const char* pos_j = strstr(text, selected[j].text);
-            
-            if (pos_j < pos_i) {
-                Sentence temp = selected[i];
-                selected[i] = selected[j];
-                selected[j] = temp;
+int add_document(DocumentCollection* collection, TokenizationResult* tokens) {
+    if (!tokens) {
+        return -1;
+    }
+    return add_document_tokens(collection, tokens->tokens, tokens->count);
+}
+
+// tokens are already distinct, so each one counts once for this document
+int add_document_tokens(DocumentCollection* collection, const Token* tokens, int count) {
+    if (!collection || !tokens) {
+        return -1;
+    }
+    
+    if (ensure_window_capacity(collection) < 0) {
+        return -1;
+    }
+    
+    CorpusDocument doc;
+    doc.term_count = 0;
+    doc.term_ids = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+    doc.added_at = time(NULL);
+    if (!doc.term_ids) {
+        return -1;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        int id = vocabulary_add(&collection->terms, tokens[i].token);
+        if (id < 0) {
+            break;
+        }
+        
+        if (id >= collection->frequency_capacity) {
+            int new_capacity = collection->terms.capacity;
+            int* new_frequency = (int*)realloc(collection->document_frequency, new_capacity * sizeof(int));
+            if (!new_frequency) {
+                break;
             }
+            memset(new_frequency + collection->frequency_capacity, 0,
+                   (new_capacity - collection->frequency_capacity) * sizeof(int));
+            collection->document_frequency = new_frequency;
+            collection->frequency_capacity = new_capacity;
+        }
+        
+        if (collection->document_frequency[id]++ == 0) {
+            collection->live_terms++;
+        }
+        doc.term_ids[doc.term_count++] = id;
+    }
+    
+    doc.bytes = sizeof(CorpusDocument) + doc.term_count * sizeof(int);
+    
+    int slot = (collection->window_start + collection->document_count) % collection->window_capacity;
+    collection->window[slot] = doc;
+    collection->document_count++;
+    collection->bytes += doc.bytes;
+    
+    enforce_collection_limits(collection, doc.added_at);
+    return doc.term_count == count ? 0 : -1;
+}
+
+int add_document_text(DocumentCollection* collection, const char* text) {
+    TokenizationResult* tokens = tokenize_text(text);
+    if (!tokens) {
+        return -1;
+    }
+    
+    int result = add_document(collection, tokens);
+    free_tokenization_result(tokens);
+    return result;
+}
+
+void free_document_collection(DocumentCollection* collection) {
+    if (collection) {
+        for (int i = 0; i < collection->document_count; i++) {
+            free(collection->window[(collection->window_start + i) % collection->window_capacity].term_ids);
+        }
+        free(collection->window);
+        vocabulary_free(&collection->terms);
+        free(collection->document_frequency);
+        free(collection);
+    }
+}
+
+
+
+char* generate_summary(const char* text, int max_sentences, DocumentCollection* collection) {
+    TextAnalysis* analysis = analyze_text(text);
+    if (!analysis) {
+        return strdup("Eroare la procesare text.");
+    }
+    
+    char* summary = generate_summary_analysis(text, analysis, max_sentences, collection);
+    free_text_analysis(analysis);
+    return summary;
+}
+
+char* generate_summary_analysis(const char* text, TextAnalysis* analysis, int max_sentences, DocumentCollection* collection) {
+    if (!analysis || !analysis->tokens) {
+        return strdup("Eroare la procesare text.");
+    }
+    
+    TokenizationResult* tokens = analysis->tokens;
+    calculate_tf_idf(tokens, collection);
+    
+    int sentence_count = 0;
+    Sentence* sentences = split_sentences(text, analysis, &sentence_count);
+    if (!sentences) {
+        return strdup("Eroare la împărțirea textului în propoziții.");
+    }
+    
+    // each distinct token of the sentence counts once, via its postings
+    for (int i = 0; i < sentence_count; i++) {
+        sentences[i].score = 0.0;
+        for (int t = 0; t < sentences[i].term_count; t++) {
+            sentences[i].score += tokens->tokens[sentences[i].terms[t]].tf_idf;
+        }
+        
+        int length = sentences[i].word_count;
+        if (length > 0) {
+            sentences[i].score /= length;
+        }
+        
+        if (i == 0 || i == sentence_count - 1) {
+            sentences[i].score *= 1.5; 
         }
     }
     
+    int summary_length = (max_sentences < sentence_count) ? max_sentences : sentence_count;
+    if (summary_length <= 0) {
+        summary_length = 1;  
+    }
+    
+    Sentence** selected = (Sentence**)scratch_alloc(analysis->arena, summary_length * sizeof(Sentence*));
+    if (!selected) {
+        scratch_free(analysis->arena, sentences);
+        return strdup("Eroare la alocarea memoriei pentru rezumat.");
+    }
+    
+    // summary in document order
+    select_top_sentences(sentences, sentence_count, selected, summary_length);
+    qsort(selected, summary_length, sizeof(Sentence*), compare_sentence_offset);
     
     size_t buffer_size = 1;  
     for (int i = 0; i < summary_length; i++) {
-        buffer_size += strlen(selected[i].text) + 1;  
+        buffer_size += selected[i]->length + 1;  
     }
     
-
     char* summary = (char*)malloc(buffer_size);
     if (!summary) {
-        for (int i = 0; i < sentence_count; i++) {
-            free(sentences[i].text);
-        }
-        free(sentences);
-        free_tokenization_result(tokens);
+        scratch_free(analysis->arena, selected);
+        scratch_free(analysis->arena, sentences);
         return strdup("Eroare la alocarea memoriei pentru rezumat.");
     }
     
-    summary[0] = '\0';
+    char* out = summary;
     for (int i = 0; i < summary_length; i++) {
-        strcat(summary, selected[i].text);
-        strcat(summary, " ");
+        memcpy(out, selected[i]->text, selected[i]->length);
+        out += selected[i]->length;
+        *out++ = ' ';
     }
+    *out = '\0';
     
-    for (int i = 0; i < sentence_count; i++) {
-        free(sentences[i].text);
+    scratch_free(analysis->arena, selected);
+    scratch_free(analysis->arena, sentences);
+    return summary;
+}
+
+
+// Analiza pe bucati. Scanerul gaseste aceleasi cuvinte ca next_token, iar
+// fiecare [.!?] incheie propozitia curenta. Cuvantul, propozitia si o
+// diacritica neterminate trec in bucata urmatoare.
+#define STREAM_SUMMARY_CANDIDATES 64
+#define STREAM_MAX_SENTENCE_LENGTH 4096
+#define STREAM_MAX_SENTENCE_TERMS 512
+#define STREAM_MAX_WORD_LENGTH 256    // ca token_buffer din add_token
+
+typedef struct {
+    char* text;             // primii STREAM_MAX_SENTENCE_LENGTH bytes
+    int length;
+    int capacity;
+    int* terms;             // indici distincti in tokens[]
+    int term_count;
+    int term_capacity;
+    int word_count;
+    int index;              // a cata propozitie din document
+    double score;
+} StreamSentence;
+
+struct StreamAnalysis {
+    int options;
+    int word_count;
+    TokenizationResult* tokens;
+    
+    // cuvantul curent; word_length se opreste la STREAM_MAX_WORD_LENGTH
+    char word[STREAM_MAX_WORD_LENGTH];
+    int word_length;
+    int word_letters;       // doar litere pana acum
+    int digit_last;         // ultimul byte al cuvantului e o cifra
+    unsigned char lead;     // primul byte al unei posibile diacritice, 0 = niciunul
+    
+    // current se construieste, pending e ultima propozitie incheiata (poate
+    // fi ultima din document), candidates sunt cele mai bune dintre restul
+    StreamSentence pool[STREAM_SUMMARY_CANDIDATES + 2];
+    int pool_used;
+    StreamSentence* current;
+    StreamSentence* pending;
+    StreamSentence* candidates[STREAM_SUMMARY_CANDIDATES];
+    int candidate_count;
+    int sentence_count;
+    int sentence_text;      // propozitia curenta are text, nu doar spatii
+    int sentence_closed;    // ultimul byte a incheiat o propozitie
+    int pending_dot;        // '.' dupa o cifra, decis de byte-ul urmator
+    int* seen;              // token -> 1 + ultima propozitie care il contine
+    int seen_capacity;
+};
+
+StreamAnalysis* stream_analysis_create(int options) {
+    StreamAnalysis* stream = (StreamAnalysis*)calloc(1, sizeof(StreamAnalysis));
+    if (!stream) {
+        return NULL;
     }
-    free(sentences);
-    free_tokenization_result(tokens);
     
-    return summary;
+    if (options & STREAM_SENTENCES) {
+        options |= STREAM_TOKENS;
+    }
+    stream->options = options;
+    stream->word_letters = 1;
+    stream->current = &stream->pool[stream->pool_used++];
+    
+    if (options & STREAM_TOKENS) {
+        stream->tokens = create_tokenization_result(NULL);
+        if (!stream->tokens) {
+            free(stream);
+            return NULL;
+        }
+    }
+    return stream;
+}
+
+void stream_analysis_free(StreamAnalysis* stream) {
+    if (!stream) return;
+    
+    free_tokenization_result(stream->tokens);
+    for (int i = 0; i < stream->pool_used; i++) {
+        free(stream->pool[i].text);
+        free(stream->pool[i].terms);
+    }
+    free(stream->seen);
+    free(stream);
+}
+
+static void append_word_byte(StreamAnalysis* stream, unsigned char c) {
+    if (stream->word_length < STREAM_MAX_WORD_LENGTH) {
+        stream->word[stream->word_length++] = c;
+    }
+}
+
+// adauga data[0..length) la textul propozitiei, pana la STREAM_MAX_SENTENCE_LENGTH
+static int append_sentence_text(StreamSentence* sentence, const char* data, size_t length) {
+    size_t room = STREAM_MAX_SENTENCE_LENGTH - sentence->length;
+    if (length > room) {
+        length = room;
+    }
+    if (length == 0) {
+        return 0;
+    }
+    
+    size_t needed = sentence->length + length + 1;
+    if (needed > (size_t)sentence->capacity) {
+        int capacity = sentence->capacity ? sentence->capacity : 256;
+        while ((size_t)capacity < needed) {
+            capacity *= 2;
+        }
+        char* text = (char*)realloc(sentence->text, capacity);
+        if (!text) {
+            return -1;
+        }
+        sentence->text = text;
+        sentence->capacity = capacity;
+    }
+    
+    memcpy(sentence->text + sentence->length, data, length);
+    sentence->length += length;
+    sentence->text[sentence->length] = '\0';
+    return 0;
 }
 
+// fiecare token distinct al propozitiei curente o singura data
+static int add_sentence_term(StreamAnalysis* stream, int index) {
+    if (index >= stream->seen_capacity) {
+        int capacity = stream->seen_capacity ? stream->seen_capacity : INITIAL_TOKEN_CAPACITY;
+        while (capacity <= index) {
+            capacity *= 2;
+        }
+        int* seen = (int*)realloc(stream->seen, capacity * sizeof(int));
+        if (!seen) {
+            return -1;
+        }
+        memset(seen + stream->seen_capacity, 0, (capacity - stream->seen_capacity) * sizeof(int));
+        stream->seen = seen;
+        stream->seen_capacity = capacity;
+    }
+    
+    int mark = stream->sentence_count + 1;
+    if (stream->seen[index] == mark) {
+        return 0;
+    }
+    stream->seen[index] = mark;
+    
+    StreamSentence* sentence = stream->current;
+    if (sentence->term_count >= STREAM_MAX_SENTENCE_TERMS) {
+        return 0;
+    }
+    if (sentence->term_count >= sentence->term_capacity) {
+        int capacity = sentence->term_capacity ? sentence->term_capacity * 2 : 16;
+        int* terms = (int*)realloc(sentence->terms, capacity * sizeof(int));
+        if (!terms) {
+            return -1;
+        }
+        sentence->terms = terms;
+        sentence->term_capacity = capacity;
+    }
+    sentence->terms[sentence->term_count++] = index;
+    return 0;
+}
+
+static int end_word(StreamAnalysis* stream) {
+    int length = stream->word_length;
+    int letters = stream->word_letters;
+    stream->word_length = 0;
+    stream->word_letters = 1;
+    stream->digit_last = 0;
+    
+    if (length == 0 || !letters) {
+        return 0;
+    }
+    
+    stream->word_count++;
+    stream->current->word_count++;
+    if (!stream->tokens) {
+        return 0;
+    }
+    if (length >= STREAM_MAX_WORD_LENGTH) {
+        end_keyword_phrase(stream->tokens);
+        return 0;
+    }
+    
+    int index;
+    if (add_token(stream->tokens, stream->word, length, &index) < 0) {
+        return -1;
+    }
+    if (index >= 0 && (stream->options & STREAM_SENTENCES)) {
+        return add_sentence_term(stream, index);
+    }
+    return 0;
+}
+
+static void reset_sentence(StreamSentence* sentence) {
+    sentence->length = 0;
+    sentence->term_count = 0;
+    sentence->word_count = 0;
+    sentence->score = 0.0;
+}
+
+// intoarce propozitia care nu mai e necesara (cea respinsa sau cea eliminata),
+// NULL daca mai era loc
+static StreamSentence* offer_candidate(StreamAnalysis* stream, StreamSentence* sentence) {
+    if (stream->candidate_count < STREAM_SUMMARY_CANDIDATES) {
+        stream->candidates[stream->candidate_count++] = sentence;
+        return NULL;
+    }
+    
+    int weakest = 0;
+    for (int i = 1; i < stream->candidate_count; i++) {
+        if (stream->candidates[i]->score < stream->candidates[weakest]->score) {
+            weakest = i;
+        }
+    }
+    
+    if (sentence->score <= stream->candidates[weakest]->score) {
+        return sentence;
+    }
+    StreamSentence* evicted = stream->candidates[weakest];
+    stream->candidates[weakest] = sentence;
+    return evicted;
+}
+
+// Scorul provizoriu foloseste frecventele de pana acum (TF-IDF final se
+// stie doar la sfarsit); decide doar care propozitii raman candidate.
+static void end_sentence(StreamAnalysis* stream) {
+    StreamSentence* sentence = stream->current;
+    sentence->index = stream->sentence_count++;
+    
+    if (!(stream->options & STREAM_SENTENCES)) {
+        reset_sentence(sentence);
+        return;
+    }
+    
+    for (int i = 0; i < sentence->term_count; i++) {
+        sentence->score += stream->tokens->tokens[sentence->terms[i]].count;
+    }
+    if (sentence->word_count > 0) {
+        sentence->score /= sentence->word_count;
+    }
+    if (stream->word_count > 0) {
+        sentence->score /= stream->word_count;
+    }
+    if (sentence->index == 0) {
+        sentence->score *= 1.5;
+    }
+    
+    StreamSentence* spare = stream->pending ? offer_candidate(stream, stream->pending) : NULL;
+    if (!spare) {
+        spare = &stream->pool[stream->pool_used++];
+    }
+    reset_sentence(spare);
+    stream->pending = sentence;
+    stream->current = spare;
+}
 
-#ifndef HAVE_STRCASESTR
-char* strcasestr(const char* haystack, const char* needle) {
-    char *p, *startn = NULL, *np = NULL;
+// incheie propozitia curenta, al carei text continua cu data[0..length)
+static int close_sentence(StreamAnalysis* stream, const char* data, size_t length) {
+    if ((stream->options & STREAM_SENTENCES) && append_sentence_text(stream->current, data, length) < 0) {
+        return -1;
+    }
+    end_sentence(stream);
+    stream->sentence_text = 0;
+    stream->sentence_closed = 1;
+    return 0;
+}
 
-    for (p = (char *)haystack; *p; p++) {
-        if (np) {
-            if (toupper(*p) == toupper(*np)) {
-                if (!*++np)
-                    return startn;
-            } else {
-                np = NULL;
+int stream_analysis_feed(StreamAnalysis* stream, const char* data, size_t length) {
+    int keep_text = stream->options & STREAM_SENTENCES;
+    size_t segment = 0;     // inceputul propozitiei curente in aceasta bucata
+    
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = data[i];
+        unsigned char cls = char_class[c];
+        
+        if (stream->pending_dot) {
+            // zecimala doar daca urmeaza tot o cifra (3.14)
+            stream->pending_dot = 0;
+            if (c < '0' || c > '9') {
+                if (stream->tokens) {
+                    end_keyword_phrase(stream->tokens);
+                }
+                if (close_sentence(stream, data + segment, i - segment) < 0) {
+                    return -1;
+                }
+                segment = i;
+            }
+        }
+        
+        if (!(cls & CHAR_TERMINATOR)) {
+            stream->sentence_closed = 0;
+            if (!(cls & CHAR_SPACE) && !stream->sentence_text) {
+                // spatiile dinaintea propozitiei nu fac parte din ea
+                stream->sentence_text = 1;
+                segment = i;
+            }
+        }
+        
+        if (stream->lead) {
+            unsigned char lead = stream->lead;
+            stream->lead = 0;
+            if (diacritic_letter(lead, c)) {
+                append_word_byte(stream, lead);
+                append_word_byte(stream, c);
+                stream->digit_last = 0;
+                continue;
+            }
+            // byte-ul anterior a fost un separator
+            if (end_word(stream) < 0) {
+                return -1;
+            }
+        }
+        
+        if (cls & (CHAR_LETTER | CHAR_DIGIT)) {
+            append_word_byte(stream, c);
+            stream->digit_last = c >= '0' && c <= '9';
+            if (cls & CHAR_DIGIT) {
+                stream->word_letters = 0;
+            }
+            continue;
+        }
+        
+        if (cls >> CHAR_LEAD_SHIFT) {
+            // se decide la byte-ul urmator, poate din bucata urmatoare
+            stream->lead = c;
+            continue;
+        }
+        
+        // un '.' se judeca dupa cuvantul lipit de el (ca ends_sentence)
+        int decimal = c == '.' && stream->digit_last;
+        int abbreviation = c == '.' && !decimal && is_abbreviation(stream->word, stream->word_length);
+        if (end_word(stream) < 0) {
+            return -1;
+        }
+        
+        if ((cls & CHAR_TERMINATOR) && decimal) {
+            stream->pending_dot = 1;
+        } else if ((cls & CHAR_TERMINATOR) && !abbreviation) {
+            if (stream->tokens) {
+                end_keyword_phrase(stream->tokens);
+            }
+            if (stream->sentence_text) {
+                if (close_sentence(stream, data + segment, i + 1 - segment) < 0) {
+                    return -1;
+                }
+            } else if (stream->sentence_closed && stream->pending && keep_text) {
+                // "?!", "...": terminatorii lipiti de propozitia anterioara;
+                // un terminator fara text inaintea lui nu formeaza propozitie
+                if (append_sentence_text(stream->pending, data + i, 1) < 0) {
+                    return -1;
+                }
             }
-        } else if (toupper(*p) == toupper(*needle)) {
-            np = (char *)needle + 1;
-            startn = p;
+            segment = i + 1;
         }
     }
-    return NULL;
+    
+    // restul bucatii apartine propozitiei neterminate
+    if (keep_text && stream->sentence_text &&
+        append_sentence_text(stream->current, data + segment, length - segment) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+int stream_analysis_finish(StreamAnalysis* stream) {
+    stream->lead = 0;
+    stream->pending_dot = 0;
+    if (end_word(stream) < 0) {
+        return -1;
+    }
+    
+    // textul de dupa ultimul terminator e ultima propozitie (ca in analyze_text)
+    if (!stream->sentence_text) {
+        return 0;
+    }
+    StreamSentence* sentence = stream->current;
+    while (sentence->length > 0 && (char_class[(unsigned char)sentence->text[sentence->length - 1]] & CHAR_SPACE)) {
+        sentence->text[--sentence->length] = '\0';
+    }
+    return close_sentence(stream, NULL, 0);
+}
+
+int stream_analysis_word_count(StreamAnalysis* stream) {
+    return stream->word_count;
+}
+
+TokenizationResult* stream_analysis_tokens(StreamAnalysis* stream) {
+    return stream->tokens;
+}
+
+static int compare_sentence_score(const void* a, const void* b) {
+    const StreamSentence* first = *(const StreamSentence* const*)a;
+    const StreamSentence* second = *(const StreamSentence* const*)b;
+    if (first->score != second->score) {
+        return first->score < second->score ? 1 : -1;
+    }
+    return first->index - second->index;
+}
+
+static int compare_sentence_index(const void* a, const void* b) {
+    const StreamSentence* first = *(const StreamSentence* const*)a;
+    const StreamSentence* second = *(const StreamSentence* const*)b;
+    return first->index - second->index;
+}
+
+char* stream_analysis_summary(StreamAnalysis* stream, int max_sentences, DocumentCollection* collection) {
+    if (!(stream->options & STREAM_SENTENCES)) {
+        return strdup("Eroare la procesare text.");
+    }
+    
+    StreamSentence* ranked[STREAM_SUMMARY_CANDIDATES + 1];
+    int count = 0;
+    for (int i = 0; i < stream->candidate_count; i++) {
+        ranked[count++] = stream->candidates[i];
+    }
+    if (stream->pending) {
+        ranked[count++] = stream->pending;
+    }
+    if (count == 0) {
+        return strdup("Eroare la împărțirea textului în propoziții.");
+    }
+    
+    // scorurile finale, ca in generate_summary_analysis
+    TokenizationResult* tokens = stream->tokens;
+    calculate_tf_idf(tokens, collection);
+    
+    for (int i = 0; i < count; i++) {
+        StreamSentence* sentence = ranked[i];
+        sentence->score = 0.0;
+        for (int t = 0; t < sentence->term_count; t++) {
+            sentence->score += tokens->tokens[sentence->terms[t]].tf_idf;
+        }
+        if (sentence->word_count > 0) {
+            sentence->score /= sentence->word_count;
+        }
+        if (sentence->index == 0 || sentence->index == stream->sentence_count - 1) {
+            sentence->score *= 1.5;
+        }
+    }
+    
+    int summary_length = (max_sentences < count) ? max_sentences : count;
+    if (summary_length <= 0) {
+        summary_length = 1;
+    }
+    
+    qsort(ranked, count, sizeof(StreamSentence*), compare_sentence_score);
+    qsort(ranked, summary_length, sizeof(StreamSentence*), compare_sentence_index);
+    
+    size_t buffer_size = 1;
+    for (int i = 0; i < summary_length; i++) {
+        buffer_size += ranked[i]->length + 1;
+    }
+    
+    char* summary = (char*)malloc(buffer_size);
+    if (!summary) {
+        return strdup("Eroare la alocarea memoriei pentru rezumat.");
+    }
+    
+    char* out = summary;
+    for (int i = 0; i < summary_length; i++) {
+        // o propozitie goala nu are inca text alocat (text e NULL)
+        if (ranked[i]->length) {
+            memcpy(out, ranked[i]->text, ranked[i]->length);
+        }
+        out += ranked[i]->length;
+        *out++ = ' ';
+    }
+    *out = '\0';
+    return summary;
 }
-#endif
\ No newline at end of file
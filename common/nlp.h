@@ -1,9 +1,18 @@
 #ifndef NLP_H
 #define NLP_H
 
+#include <stddef.h>
+#include <time.h>
+
 /* Structura pentru rezultatul tokenizarii */
 typedef struct TokenizationResult TokenizationResult;
 
+// Arena (bump allocator) pentru memoria temporara a unei cereri: tokeni,
+// tabele, propozitii. Alocarile nu se elibereaza individual; arena_reset
+// le elibereaza pe toate in O(1) si pastreaza blocurile pentru cererea
+// urmatoare. O arena e folosita de un singur thread.
+typedef struct Arena Arena;
+
 
 typedef struct {
     char* token;
@@ -13,55 +22,244 @@ typedef struct {
     double tf_idf;    // TF-IDF score
 } Token;
 
-// Struct pentru a stoca documentele procesate
+// Vocabular: cuvant -> id dens (0, 1, 2, ...), tabel hash cu adresare deschisa
+typedef struct {
+    char** words;           // id -> cuvant
+    unsigned int* hashes;   // id -> hash-ul cuvantului
+    int count;
+    int capacity;
+    int* slots;             // id sau -1 (gol); putere a lui 2, cel mult pe jumatate plin
+    int slot_capacity;
+    const char* pool;       // cuvintele din acest bloc nu sunt eliberate (snapshot mapat)
+    size_t pool_size;
+} Vocabulary;
+
+// Un document din fereastra corpusului: doar id-urile termenilor sai distincti
+typedef struct {
+    int* term_ids;
+    int term_count;
+    size_t bytes;       // memoria ocupata de document in corpus
+    time_t added_at;
+} CorpusDocument;
+
+// Colectia documentelor procesate, pastrata ca index de frecventa:
+// pentru fiecare termen, numarul de documente care il contin.
+// Documentele formeaza o fereastra FIFO limitata ca numar, memorie si
+// varsta; la eliminare frecventele sunt decrementate.
 typedef struct {
-    char** documents;
     int document_count;
+    Vocabulary terms;
+    int* document_frequency;  // id termen -> nr documente
+    int frequency_capacity;
+    int live_terms;           // termeni cu frecventa > 0
+    
+    CorpusDocument* window;   // coada circulara, cel mai vechi la window_start
+    int window_start;
+    int window_capacity;
+    size_t bytes;
+    
+    int max_documents;        // 0 = nelimitat
+    size_t max_bytes;         // 0 = nelimitat
+    int max_age;              // secunde, 0 = nelimitat
 } DocumentCollection;
 
 typedef struct {
     char* domain;
     double probability;  // Probabilitatea initiala a clasei
     int document_count;  // Nr de documente in aceasta clasa
-    // Tabel hash pentru cuvinte si frecv lor in aceasta clasa
-    struct {
-        char* word;
-        int count;
-    } *word_counts;
-    int word_count_size;
+    // Frecventele cuvintelor, indexate dupa id-ul din vocabularul comun
+    int* word_counts;
+    double* log_counts;      // log(word_counts[id] + 1), precalculat la antrenare
+    int capacity;            // dimensiunea tablourilor de mai sus
+    int word_count_size;     // Nr de cuvinte distincte din aceasta clasa
+    long total_words;        // Suma word_counts, mentinuta la antrenare
 } DomainBayes;
 
 typedef struct {
     DomainBayes* domains;
     int count;
     int total_documents;
+    Vocabulary vocabulary;   // comun tuturor domeniilor
+    void* snapshot;          // maparea din care a fost incarcat modelul, sau NULL
+    size_t snapshot_size;
 } BayesClassifier;
 
+int vocabulary_init(Vocabulary* vocabulary);
+
+void vocabulary_free(Vocabulary* vocabulary);
+
+// id-ul cuvantului sau -1 daca nu exista
+int vocabulary_lookup(const Vocabulary* vocabulary, const char* word);
+
+// id-ul cuvantului, adaugat daca nu exista; -1 la eroare de alocare,
+// cand vocabularul ramane neschimbat
+int vocabulary_add(Vocabulary* vocabulary, const char* word);
+
+// Propozitie din textul original, ca interval (offset, lungime) in bytes,
+// fara spatiile din jur; tokenii ei distincti sunt
+// terms[term_start .. term_start + term_count). O propozitie se incheie la
+// [.!?] (vezi ends_sentence) sau la sfarsitul textului; terminatorii lipiti
+// ("?!", "...") raman in ea.
+typedef struct {
+    int offset;
+    int length;
+    int word_count;
+    int term_start;
+    int term_count;
+} SentenceSpan;
+
+// Rezultatul unei singure treceri peste text: numarul de cuvinte,
+// tabela de tokeni si propozitiile, refolosite de toate tipurile de cereri
+typedef struct {
+    int word_count;
+    TokenizationResult* tokens;
+    SentenceSpan* sentences;
+    int sentence_count;
+    int* terms;         // postings token -> propozitie: indici in tokens, grupati pe propozitii
+    int term_count;
+    Arena* arena;       // memoria analizei (NULL = malloc)
+} TextAnalysis;
+
+// block_size: dimensiunea blocurilor (alocarile mai mari primesc bloc propriu)
+Arena* arena_create(size_t block_size);
+
+void* arena_alloc(Arena* arena, size_t size);
+
+void arena_reset(Arena* arena);
+
+void arena_destroy(Arena* arena);
+
 // init clasificator
 BayesClassifier* init_bayes_classifier();
 
-// Antrenare clasificator
+// Clasificator fara domenii (se adauga cu add_bayes_domain)
+BayesClassifier* create_bayes_classifier();
+
+// Indexul domeniului, adaugat daca nu exista; -1 la eroare de alocare
+int add_bayes_domain(BayesClassifier* classifier, const char* domain);
+
+// Antrenare clasificator; un domeniu nou se adauga (vezi add_bayes_domain)
 void train_bayes_classifier(BayesClassifier* classifier, const char* text, const char* domain);
 
+// Antrenare cu tokeni deja extrasi (de ex. din analyze_text)
+void train_bayes_classifier_tokens(BayesClassifier* classifier, TokenizationResult* tokens, const char* domain);
+
+// Un document de antrenare care nu depinde de memoria cererii: domeniul si
+// tokenii cu frecventele lor, copiati intr-un singur bloc (eliberat cu free)
+typedef struct {
+    char* domain;
+    Token* tokens;
+    int count;
+    size_t size;        // bytes ai blocului
+} TrainingExample;
+
+// NULL la eroare de alocare
+TrainingExample* create_training_example(TokenizationResult* tokens, const char* domain);
+TrainingExample* copy_training_example(const TrainingExample* example);
+
+void train_bayes_classifier_example(BayesClassifier* classifier, const TrainingExample* example);
+
+// Aduna in into contoarele din from, ca si cum into ar fi fost antrenat si
+// cu documentele lui from (domeniile se potrivesc dupa nume, cele noi se
+// adauga). -1 la eroare de alocare.
+int merge_bayes_classifier(BayesClassifier* into, const BayesClassifier* from);
+
 // Clasificare text
 char* classify_text_bayes(BayesClassifier* classifier, const char* text);
 
+// Clasificare pe baza tokenilor deja extrasi. "Necunoscut" daca modelul
+// nu are documente sau textul nu are niciun cuvant din vocabular.
+char* classify_tokens_bayes(BayesClassifier* classifier, TokenizationResult* tokens);
+
 // Eliberare resurse
 void free_bayes_classifier(BayesClassifier* classifier);
 
 // functia pentru calculul TF-IDF
 void calculate_tf_idf(TokenizationResult* result, DocumentCollection* collection);
 
+DocumentCollection* create_document_collection(void);
+
+// Limitele ferestrei (0 = nelimitat); documentele in plus sunt eliminate imediat
+void set_collection_limits(DocumentCollection* collection, int max_documents, size_t max_bytes, int max_age);
+
+// Elimina documentele care depasesc limitele (cele mai vechi primele)
+void enforce_collection_limits(DocumentCollection* collection, time_t now);
+
+// Adauga un document in index (fiecare token distinct conteaza o data)
+int add_document(DocumentCollection* collection, TokenizationResult* tokens);
+// La fel, pentru tokeni pastrati in afara unei tokenizari (de ex. TrainingExample)
+int add_document_tokens(DocumentCollection* collection, const Token* tokens, int count);
+
+int add_document_text(DocumentCollection* collection, const char* text);
+
+void free_document_collection(DocumentCollection* collection);
+
 
 int count_words(const char* text);
 
+// Tokenii pierd si diacriticele (ă -> a, ș -> s, ...), ca textele scrise
+// fara diacritice sa se potriveasca cu cele scrise corect. Se seteaza o
+// singura data, inainte de orice tokenizare.
+void set_strip_diacritics(int enabled);
+
+// Cuvintele cheie pentru determine_topic: listele incorporate plus fisierele
+// date (vezi keyword_set_load). Se apeleaza o singura data, dupa
+// set_strip_diacritics si inainte de orice tokenizare; fara apel se folosesc
+// doar listele incorporate. Intoarce numarul de fraze sau -1 la eroare.
+int load_topic_keywords(const char* const* paths, int count);
+
 
 TokenizationResult* tokenize_text(const char* text);
 
+// Ca tokenize_text, dar toata memoria vine din arena (valabila pana la arena_reset)
+TokenizationResult* tokenize_text_arena(const char* text, Arena* arena);
+
+// Nu face nimic pentru rezultatele alocate in arena
 void free_tokenization_result(TokenizationResult* result);
 
+// Analiza completa a textului intr-o singura trecere
+TextAnalysis* analyze_text(const char* text);
+
+TextAnalysis* analyze_text_arena(const char* text, Arena* arena);
+
+void free_text_analysis(TextAnalysis* analysis);
+
 char* determine_topic(const char* text);
 
+char* determine_topic_tokens(TokenizationResult* tokens);
+
 char* generate_summary(const char* text, int max_sentences, DocumentCollection* collection);
 
+// Rezumat pe baza unei analize existente a aceluiasi text; memoria temporara
+// vine din arena analizei, daca are una. Rezumatul intors e alocat cu malloc.
+char* generate_summary_analysis(const char* text, TextAnalysis* analysis, int max_sentences, DocumentCollection* collection);
+
+// Analiza incrementala a unui document primit pe bucati, oricat de lung.
+// Cuvintele si propozitiile taiate de granita dintre bucati sunt tratate ca
+// in analyze_text. Memoria nu creste cu documentul: tabela de tokeni creste
+// doar cu vocabularul, iar pentru rezumat se pastreaza un numar fix de
+// propozitii candidate (primii 4 KB din fiecare).
+typedef struct StreamAnalysis StreamAnalysis;
+
+#define STREAM_TOKENS 1       // tabela de tokeni (topic, corpus)
+#define STREAM_SENTENCES 2    // propozitii pentru rezumat (implica STREAM_TOKENS)
+
+StreamAnalysis* stream_analysis_create(int options);
+
+// -1 la eroare de alocare
+int stream_analysis_feed(StreamAnalysis* stream, const char* data, size_t length);
+
+// Dupa ultima bucata: incheie cuvantul ramas deschis
+int stream_analysis_finish(StreamAnalysis* stream);
+
+int stream_analysis_word_count(StreamAnalysis* stream);
+
+// NULL fara STREAM_TOKENS; ramane proprietatea analizei
+TokenizationResult* stream_analysis_tokens(StreamAnalysis* stream);
+
+// Rezumatul din propozitiile candidate, rescorate cu TF-IDF final
+char* stream_analysis_summary(StreamAnalysis* stream, int max_sentences, DocumentCollection* collection);
+
+void stream_analysis_free(StreamAnalysis* stream);
+
 #endif
\ No newline at end of file
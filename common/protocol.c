@@ -3,38 +3,195 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <errno.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 
-// functii pentru cereri normale
-int send_request(int sockfd, Request* req) {
-    // trimitere tip cerere
-    if (write(sockfd, &req->type, sizeof(req->type)) < 0) {
-        return -1;
+int enable_tcp_nodelay(int sockfd) {
+    int on = 1;
+    return setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+// Scrie toate bucatile cu writev, reluand dupa scrierile partiale
+static int write_all(int sockfd, struct iovec* iov, int count) {
+    while (count > 0) {
+        ssize_t written = writev(sockfd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        
+        while (count > 0 && (size_t)written >= iov->iov_len) {
+            written -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
     }
-    
-    // trimitere dimensiune text
-    size_t text_len = strlen(req->text) + 1;
-    if (write(sockfd, &text_len, sizeof(text_len)) < 0) {
-        return -1;
+    return 0;
+}
+
+// Citeste exact size bytes, reluand dupa citirile partiale
+static int read_exact(int sockfd, void* data, size_t size) {
+    char* out = (char*)data;
+    while (size > 0) {
+        ssize_t received = read(sockfd, out, size);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) {
+            return -1;
+        }
+        out += received;
+        size -= received;
+    }
+    return 0;
+}
+
+static void store_le(char* out, uint64_t value, int size) {
+    for (int i = 0; i < size; i++) {
+        out[i] = (char)(value >> (8 * i));
+    }
+}
+
+static uint64_t load_le(const char* data, int size) {
+    uint64_t value = 0;
+    for (int i = size - 1; i >= 0; i--) {
+        value = value << 8 | (unsigned char)data[i];
+    }
+    return value;
+}
+
+static char* append_field(char* out, const void* data, size_t size) {
+    if (size > 0) {
+        memcpy(out, data, size);
+    }
+    return out + size;
+}
+
+// Campurile numerice: in v1 in ordinea masinii (int, size_t, double),
+// in v2 little-endian (uint32, uint64, double IEEE pe 64 de biti)
+static char* append_u32(char* out, uint32_t value, int version) {
+    if (version >= 2) {
+        store_le(out, value, 4);
+        return out + 4;
+    }
+    return append_field(out, &value, sizeof(value));
+}
+
+static size_t length_field_size(int version) {
+    return version >= 2 ? 8 : sizeof(size_t);
+}
+
+static char* append_length(char* out, size_t length, int version) {
+    if (version >= 2) {
+        store_le(out, length, 8);
+        return out + 8;
+    }
+    return append_field(out, &length, sizeof(length));
+}
+
+static char* append_double(char* out, double value, int version) {
+    if (version >= 2) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        store_le(out, bits, 8);
+        return out + 8;
+    }
+    return append_field(out, &value, sizeof(value));
+}
+
+static uint32_t load_u32(const char* data, int version) {
+    if (version >= 2) {
+        return (uint32_t)load_le(data, 4);
+    }
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint64_t load_length(const char* data, int version) {
+    if (version >= 2) {
+        return load_le(data, 8);
+    }
+    size_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Sirurile din raspunsuri: lungimea, apoi textul (in v1 cu '\0', in v2 fara)
+static size_t string_length(const char* text, int version) {
+    return text ? strlen(text) + (version >= 2 ? 0 : 1) : 0;
+}
+
+static char* append_string(char* out, const char* text, int version) {
+    size_t len = string_length(text, version);
+    out = append_length(out, len, version);
+    return append_field(out, text, len);
+}
+
+static void encode_frame_header(char* out, int type, int flags, unsigned int request_id, uint64_t length) {
+    store_le(out, PROTOCOL_MAGIC, 4);
+    out[4] = PROTOCOL_VERSION;
+    out[5] = (char)type;
+    store_le(out + 6, flags, 2);
+    store_le(out + 8, request_id, 4);
+    store_le(out + 12, length, 8);
+}
+
+// Antetul unei cereri in formatul req->version (cel mult
+// REQUEST_HEADER_MAX_SIZE bytes); intoarce lungimea lui
+static size_t encode_request_header(char* out, Request* req, int type, int flags, size_t length) {
+    if (req->version >= 2) {
+        encode_frame_header(out, type, flags, req->request_id, length);
+        return FRAME_HEADER_SIZE;
     }
     
-    // trimitere text
-    if (write(sockfd, req->text, text_len) < 0) {
-        return -1;
+    int type_word = type | flags;
+    char* end = append_field(out, &type_word, sizeof(type_word));
+    if (flags & REQUEST_FLAG_ID) {
+        end = append_field(end, &req->request_id, sizeof(req->request_id));
     }
+    end = append_field(end, &length, sizeof(length));
+    return end - out;
+}
+
+// functii pentru cereri normale
+int send_request(int sockfd, Request* req) {
+    // antet si text intr-un singur writev; in v2 textul pleaca fara '\0'
+    size_t text_len = strlen(req->text) + (req->version >= 2 ? 0 : 1);
+    char header[REQUEST_HEADER_MAX_SIZE];
     
-    return 0;
+    struct iovec iov[2];
+    iov[0].iov_base = header;
+    iov[0].iov_len = encode_request_header(header, req, req->type, req->flags, text_len);
+    iov[1].iov_base = req->text;
+    iov[1].iov_len = text_len;
+    
+    return write_all(sockfd, iov, 2);
 }
 
 int receive_request(int sockfd, Request* req) {
     // primire tip cerere
-    if (read(sockfd, &req->type, sizeof(req->type)) <= 0) {
+    int type;
+    if (read_exact(sockfd, &type, sizeof(type)) < 0) {
         return -1;
     }
+    req->version = 1;
+    req->type = type & REQUEST_TYPE_MASK;
+    req->flags = type & ~REQUEST_TYPE_MASK;
+    
+    if (req->flags & REQUEST_FLAG_ID) {
+        if (read_exact(sockfd, &req->request_id, sizeof(req->request_id)) < 0) {
+            return -1;
+        }
+    }
     
     // primire dimensiune text
     size_t text_len;
-    if (read(sockfd, &text_len, sizeof(text_len)) <= 0) {
+    if (read_exact(sockfd, &text_len, sizeof(text_len)) < 0) {
         return -1;
     }
     
@@ -43,7 +200,7 @@ int receive_request(int sockfd, Request* req) {
     }
     
     // primire text
-    if (read(sockfd, req->text, text_len) <= 0) {
+    if (read_exact(sockfd, req->text, text_len) < 0) {
         return -1;
     }
     
@@ -51,87 +208,162 @@ int receive_request(int sockfd, Request* req) {
 }
 
 int send_response(int sockfd, Response* resp) {
-    // trimitere status
-    if (write(sockfd, &resp->status, sizeof(resp->status)) < 0) {
+    // tot raspunsul dintr-un singur buffer, nu cate un write pe camp
+    size_t length;
+    char* frame = encode_response(resp, &length);
+    if (!frame) {
         return -1;
     }
     
-    if (resp->status == STATUS_OK) {
-        // trimitere numar cuvinte (pentru toate tipurile de cereri)
-        if (write(sockfd, &resp->word_count, sizeof(resp->word_count)) < 0) {
+    struct iovec iov = { frame, length };
+    int result = write_all(sockfd, &iov, 1);
+    free(frame);
+    return result;
+}
+
+// Un cadru v2 intreg: antetul (verificat) si payload-ul, citit dintr-o data
+static char* receive_frame(int sockfd, Response* resp, size_t* length) {
+    char header[FRAME_HEADER_SIZE];
+    if (read_exact(sockfd, header, sizeof(header)) < 0 ||
+        load_le(header, 4) != PROTOCOL_MAGIC || header[4] != PROTOCOL_VERSION) {
+        return NULL;
+    }
+    
+    uint64_t payload_len = load_le(header + 12, 8);
+    if (payload_len > MAX_FRAME_SIZE) {
+        return NULL;
+    }
+    resp->type = (unsigned char)header[5];
+    resp->flags = (int)load_le(header + 6, 2);
+    resp->request_id = (unsigned int)load_le(header + 8, 4);
+    
+    char* payload = (char*)malloc(payload_len ? payload_len : 1);
+    if (!payload) {
+        return NULL;
+    }
+    if (read_exact(sockfd, payload, payload_len) < 0) {
+        free(payload);
+        return NULL;
+    }
+    
+    *length = payload_len;
+    return payload;
+}
+
+// sir v2 din payload, copiat intr-un buffer nou (NULL daca e gol)
+static int decode_string(const char** cursor, const char* end, char** text) {
+    const char* in = *cursor;
+    *text = NULL;
+    if ((size_t)(end - in) < 8) {
+        return -1;
+    }
+    uint64_t len = load_le(in, 8);
+    in += 8;
+    if (len > (uint64_t)(end - in)) {
+        return -1;
+    }
+    
+    if (len > 0) {
+        *text = (char*)malloc(len + 1);
+        if (!*text) {
             return -1;
         }
-        
-        // trimitere timp de procesare
-        if (write(sockfd, &resp->processing_time, sizeof(resp->processing_time)) < 0) {
+        memcpy(*text, in, len);
+        (*text)[len] = '\0';
+    }
+    *cursor = in + len;
+    return 0;
+}
+
+// Corpul unui raspuns v2 (fara antet), de la *cursor; avanseaza cursorul
+static int decode_response_body(const char** cursor, const char* end, Response* resp) {
+    const char* in = *cursor;
+    resp->topic = NULL;
+    resp->summary = NULL;
+    
+    if (end - in < 4) {
+        return -1;
+    }
+    resp->status = (StatusCode)load_le(in, 4);
+    in += 4;
+    
+    if (resp->status == STATUS_OK) {
+        if (end - in < 12) {
             return -1;
         }
+        resp->word_count = (int32_t)load_le(in, 4);
+        uint64_t bits = load_le(in + 4, 8);
+        memcpy(&resp->processing_time, &bits, sizeof(bits));
+        in += 12;
         
-        // trimitere topic (daca exista)
-        if (resp->topic) {
-            size_t topic_len = strlen(resp->topic) + 1;
-            if (write(sockfd, &topic_len, sizeof(topic_len)) < 0) {
-                return -1;
-            }
-            if (write(sockfd, resp->topic, topic_len) < 0) {
-                return -1;
-            }
-        } else {
-            size_t topic_len = 0;
-            if (write(sockfd, &topic_len, sizeof(topic_len)) < 0) {
-                return -1;
-            }
-        }
-        
-        // trimitere rezumat (daca exista)
-        if (resp->summary) {
-            size_t summary_len = strlen(resp->summary) + 1;
-            if (write(sockfd, &summary_len, sizeof(summary_len)) < 0) {
-                return -1;
-            }
-            if (write(sockfd, resp->summary, summary_len) < 0) {
-                return -1;
-            }
-        } else {
-            size_t summary_len = 0;
-            if (write(sockfd, &summary_len, sizeof(summary_len)) < 0) {
-                return -1;
-            }
+        if (decode_string(&in, end, &resp->topic) < 0 ||
+            decode_string(&in, end, &resp->summary) < 0) {
+            free(resp->topic);
+            resp->topic = NULL;
+            return -1;
         }
     } else {
-        // trimitere mesaj de eroare
-        size_t error_len = strlen(resp->error_message) + 1;
-        if (write(sockfd, &error_len, sizeof(error_len)) < 0) {
+        if (end - in < 8) {
             return -1;
         }
-        if (write(sockfd, resp->error_message, error_len) < 0) {
+        uint64_t error_len = load_le(in, 8);
+        in += 8;
+        if (error_len >= MAX_ERROR_MSG || error_len > (uint64_t)(end - in)) {
             return -1;
         }
+        memcpy(resp->error_message, in, error_len);
+        resp->error_message[error_len] = '\0';
+        in += error_len;
     }
     
+    *cursor = in;
     return 0;
 }
 
 int receive_response(int sockfd, Response* resp) {
+    if (resp->version >= 2) {
+        size_t length;
+        char* payload = receive_frame(sockfd, resp, &length);
+        if (!payload) {
+            return -1;
+        }
+        
+        const char* cursor = payload;
+        int result = decode_response_body(&cursor, payload + length, resp);
+        if (result == 0 && cursor != payload + length) {
+            free(resp->topic);
+            free(resp->summary);
+            result = -1;
+        }
+        free(payload);
+        return result;
+    }
+    
+    if (resp->flags & REQUEST_FLAG_ID) {
+        if (read_exact(sockfd, &resp->request_id, sizeof(resp->request_id)) < 0) {
+            return -1;
+        }
+    }
+    
     // primire status
-    if (read(sockfd, &resp->status, sizeof(resp->status)) <= 0) {
+    if (read_exact(sockfd, &resp->status, sizeof(resp->status)) < 0) {
         return -1;
     }
     
     if (resp->status == STATUS_OK) {
         // primire numar cuvinte
-        if (read(sockfd, &resp->word_count, sizeof(resp->word_count)) <= 0) {
+        if (read_exact(sockfd, &resp->word_count, sizeof(resp->word_count)) < 0) {
             return -1;
         }
         
         // primire timp de procesare
-        if (read(sockfd, &resp->processing_time, sizeof(resp->processing_time)) <= 0) {
+        if (read_exact(sockfd, &resp->processing_time, sizeof(resp->processing_time)) < 0) {
             return -1;
         }
         
         // primire topic
         size_t topic_len;
-        if (read(sockfd, &topic_len, sizeof(topic_len)) <= 0) {
+        if (read_exact(sockfd, &topic_len, sizeof(topic_len)) < 0) {
             return -1;
         }
         
@@ -140,7 +372,7 @@ int receive_response(int sockfd, Response* resp) {
             if (!resp->topic) {
                 return -1;
             }
-            if (read(sockfd, resp->topic, topic_len) <= 0) {
+            if (read_exact(sockfd, resp->topic, topic_len) < 0) {
                 free(resp->topic);
                 return -1;
             }
@@ -150,7 +382,7 @@ int receive_response(int sockfd, Response* resp) {
         
         // primire rezumat
         size_t summary_len;
-        if (read(sockfd, &summary_len, sizeof(summary_len)) <= 0) {
+        if (read_exact(sockfd, &summary_len, sizeof(summary_len)) < 0) {
             if (resp->topic) free(resp->topic);
             return -1;
         }
@@ -161,7 +393,7 @@ int receive_response(int sockfd, Response* resp) {
                 if (resp->topic) free(resp->topic);
                 return -1;
             }
-            if (read(sockfd, resp->summary, summary_len) <= 0) {
+            if (read_exact(sockfd, resp->summary, summary_len) < 0) {
                 if (resp->topic) free(resp->topic);
                 free(resp->summary);
                 return -1;
@@ -172,7 +404,7 @@ int receive_response(int sockfd, Response* resp) {
     } else {
         // primire mesaj de eroare
         size_t error_len;
-        if (read(sockfd, &error_len, sizeof(error_len)) <= 0) {
+        if (read_exact(sockfd, &error_len, sizeof(error_len)) < 0) {
             return -1;
         }
         
@@ -180,11 +412,383 @@ int receive_response(int sockfd, Response* resp) {
             return -1;
         }
         
-        if (read(sockfd, resp->error_message, error_len) <= 0) {
+        if (read_exact(sockfd, resp->error_message, error_len) < 0) {
+            return -1;
+        }
+    }
+    
+    return 0;
+}
+
+size_t request_header_size(const char* data) {
+    if (load_le(data, 4) == PROTOCOL_MAGIC) {
+        return FRAME_HEADER_SIZE;
+    }
+    
+    int type;
+    memcpy(&type, data, sizeof(type));
+    
+    if (type & REQUEST_FLAG_ID) {
+        return REQUEST_HEADER_ID_SIZE;
+    }
+    return REQUEST_HEADER_MIN_SIZE;
+}
+
+// decodifica antetul unei cereri (request_header_size bytes)
+int decode_request_header(const char* data, RequestHeader* header) {
+    uint64_t length;
+    
+    if (load_le(data, 4) == PROTOCOL_MAGIC) {
+        header->version = (unsigned char)data[4];
+        header->type = (unsigned char)data[5];
+        header->flags = (int)load_le(data + 6, 2);
+        header->request_id = (unsigned int)load_le(data + 8, 4);
+        length = load_le(data + 12, 8);
+        
+        if (header->version != PROTOCOL_VERSION) {
+            // payload-ul se citeste si se ignora; raspunsul e o eroare v2
+            if (length > MAX_TEXT_SIZE) {
+                return -1;
+            }
+            header->text_length = length;
+            return 0;
+        }
+    } else {
+        int type;
+        memcpy(&type, data, sizeof(type));
+        data += sizeof(type);
+        
+        header->version = 1;
+        header->type = type & REQUEST_TYPE_MASK;
+        header->flags = type & ~REQUEST_TYPE_MASK;
+        header->request_id = 0;
+        
+        if (header->flags & REQUEST_FLAG_ID) {
+            memcpy(&header->request_id, data, sizeof(header->request_id));
+            data += sizeof(header->request_id);
+        }
+        
+        size_t text_len;
+        memcpy(&text_len, data, sizeof(text_len));
+        length = text_len;
+    }
+    
+    if (header->flags & ~(REQUEST_FLAG_ID | REQUEST_FLAG_STREAM)) {
+        return -1; // flag necunoscut
+    }
+    
+    if ((header->flags & REQUEST_FLAG_STREAM) && header->type == REQUEST_BATCH) {
+        return -1;
+    }
+    
+    size_t max_length = header->type == REQUEST_BATCH ? MAX_BATCH_SIZE : MAX_TEXT_SIZE;
+    if (length > max_length) {
+        return -1;
+    }
+    header->text_length = length;
+    
+    return 0;
+}
+
+// dimensiunea raspunsului fara request_id sau antet
+static size_t response_body_size(Response* resp, int version) {
+    size_t size = sizeof(uint32_t);
+    
+    if (resp->status == STATUS_OK) {
+        size += sizeof(uint32_t) + sizeof(double);
+        size += length_field_size(version) + string_length(resp->topic, version);
+        size += length_field_size(version) + string_length(resp->summary, version);
+    } else {
+        size += length_field_size(version) + string_length(resp->error_message, version);
+    }
+    
+    return size;
+}
+
+static char* append_response_body(char* out, Response* resp, int version) {
+    out = append_u32(out, resp->status, version);
+    if (resp->status == STATUS_OK) {
+        out = append_u32(out, resp->word_count, version);
+        out = append_double(out, resp->processing_time, version);
+        out = append_string(out, resp->topic, version);
+        out = append_string(out, resp->summary, version);
+    } else {
+        out = append_string(out, resp->error_message, version);
+    }
+    return out;
+}
+
+// Inceputul cadrului de raspuns: antetul v2 sau, in v1, request_id-ul daca
+// a fost cerut. Intoarce cati bytes ocupa (out NULL doar ii numara).
+static size_t encode_response_header(char* out, Response* resp, size_t payload_len) {
+    if (resp->version >= 2) {
+        if (out) {
+            encode_frame_header(out, resp->type, resp->flags, resp->request_id, payload_len);
+        }
+        return FRAME_HEADER_SIZE;
+    }
+    
+    if (!(resp->flags & REQUEST_FLAG_ID)) {
+        return 0;
+    }
+    if (out) {
+        append_field(out, &resp->request_id, sizeof(resp->request_id));
+    }
+    return sizeof(resp->request_id);
+}
+
+// construieste raspunsul in acelasi format ca send_response, intr-un singur buffer
+char* encode_response(Response* resp, size_t* length) {
+    size_t body_size = response_body_size(resp, resp->version);
+    size_t header_size = encode_response_header(NULL, resp, body_size);
+    
+    char* buffer = (char*)malloc(header_size + body_size);
+    if (!buffer) {
+        return NULL;
+    }
+    
+    encode_response_header(buffer, resp, body_size);
+    append_response_body(buffer + header_size, resp, resp->version);
+    
+    *length = header_size + body_size;
+    return buffer;
+}
+
+int send_stream_chunk(int sockfd, Request* req, const char* data, size_t length) {
+    if (length > MAX_TEXT_SIZE) {
+        return -1;
+    }
+    
+    // antetul si bucata intr-un singur writev
+    char header[REQUEST_HEADER_MAX_SIZE];
+    struct iovec iov[2];
+    iov[0].iov_base = header;
+    iov[0].iov_len = encode_request_header(header, req, req->type, req->flags | REQUEST_FLAG_STREAM, length);
+    iov[1].iov_base = (void*)data;
+    iov[1].iov_len = length;
+    
+    return write_all(sockfd, iov, length > 0 ? 2 : 1);
+}
+
+// functii pentru loturi de documente
+
+// Textele elementelor se trimit cu '\0' in ambele versiuni, ca serverul
+// sa le poata folosi direct din payload.
+char* encode_batch_request(BatchItem* items, int count, int version, size_t* length) {
+    size_t size = sizeof(uint32_t);
+    
+    for (int i = 0; i < count; i++) {
+        size += sizeof(uint32_t) + length_field_size(version) + strlen(items[i].text) + 1;
+    }
+    
+    char* buffer = (char*)malloc(size);
+    if (!buffer) {
+        return NULL;
+    }
+    
+    char* out = append_u32(buffer, count, version);
+    for (int i = 0; i < count; i++) {
+        size_t text_len = strlen(items[i].text) + 1;
+        out = append_u32(out, items[i].type, version);
+        out = append_length(out, text_len, version);
+        out = append_field(out, items[i].text, text_len);
+    }
+    
+    *length = size;
+    return buffer;
+}
+
+unsigned int batch_item_count(const char* payload, size_t length, int version) {
+    return length >= sizeof(uint32_t) ? load_u32(payload, version) : 0;
+}
+
+// Imparte payload-ul in elemente. Textele raman in payload (fiecare se
+// termina cu '\0'), deci items[] e valid cat timp payload-ul exista.
+int decode_batch_request(const char* payload, size_t length, int version, BatchItem* items, int max_items) {
+    if (length < sizeof(uint32_t)) {
+        return -1;
+    }
+    unsigned int item_count = load_u32(payload, version);
+    if (item_count > (unsigned int)max_items) {
+        return -1;
+    }
+    
+    size_t field_size = length_field_size(version);
+    size_t offset = sizeof(uint32_t);
+    for (unsigned int i = 0; i < item_count; i++) {
+        if (length - offset < sizeof(uint32_t) + field_size) {
+            return -1;
+        }
+        uint32_t type = load_u32(payload + offset, version);
+        offset += sizeof(uint32_t);
+        uint64_t text_len = load_length(payload + offset, version);
+        offset += field_size;
+        
+        // doar cereri simple; fara loturi imbricate
+        if (type < REQUEST_COUNT_WORDS || type > REQUEST_GENERATE_SUMMARY) {
             return -1;
         }
+        if (text_len == 0 || text_len > MAX_TEXT_SIZE || text_len > length - offset ||
+            payload[offset + text_len - 1] != '\0') {
+            return -1;
+        }
+        
+        items[i].type = (RequestType)type;
+        items[i].text = payload + offset;
+        offset += text_len;
     }
     
+    return offset == length ? (int)item_count : -1;
+}
+
+// Raspunsul la un lot: antetul (sau [request_id] in v1), status, numarul de
+// elemente, apoi fiecare raspuns in formatul obisnuit, fara antet. Un lot
+// respins are forma unui raspuns de eroare obisnuit.
+char* encode_batch_response(Response* batch, Response* items, int count, size_t* length) {
+    size_t body_size;
+    if (batch->status == STATUS_OK) {
+        body_size = 2 * sizeof(uint32_t);
+        for (int i = 0; i < count; i++) {
+            body_size += response_body_size(&items[i], batch->version);
+        }
+    } else {
+        body_size = response_body_size(batch, batch->version);
+    }
+    size_t header_size = encode_response_header(NULL, batch, body_size);
+    
+    char* buffer = (char*)malloc(header_size + body_size);
+    if (!buffer) {
+        return NULL;
+    }
+    
+    encode_response_header(buffer, batch, body_size);
+    char* out = buffer + header_size;
+    
+    if (batch->status == STATUS_OK) {
+        out = append_u32(out, batch->status, batch->version);
+        out = append_u32(out, count, batch->version);
+        for (int i = 0; i < count; i++) {
+            out = append_response_body(out, &items[i], batch->version);
+        }
+    } else {
+        append_response_body(out, batch, batch->version);
+    }
+    
+    *length = header_size + body_size;
+    return buffer;
+}
+
+int send_batch_request(int sockfd, Request* req, BatchItem* items, int count) {
+    size_t payload_len;
+    char* payload = encode_batch_request(items, count, req->version, &payload_len);
+    if (!payload) {
+        return -1;
+    }
+    
+    // antetul si payload-ul intr-un singur writev
+    char header[REQUEST_HEADER_MAX_SIZE];
+    struct iovec iov[2];
+    iov[0].iov_base = header;
+    iov[0].iov_len = encode_request_header(header, req, REQUEST_BATCH, req->flags, payload_len);
+    iov[1].iov_base = payload;
+    iov[1].iov_len = payload_len;
+    
+    int result = write_all(sockfd, iov, 2);
+    free(payload);
+    return result;
+}
+
+// raspunsul v2 la un lot, decodificat din payload-ul citit intreg
+static int decode_batch_response(const char* payload, size_t length, Response* batch, Response** items, int* count) {
+    const char* cursor = payload;
+    const char* end = payload + length;
+    
+    if (length < sizeof(uint32_t) || load_le(payload, 4) != STATUS_OK) {
+        return decode_response_body(&cursor, end, batch);
+    }
+    if (length < 2 * sizeof(uint32_t)) {
+        return -1;
+    }
+    batch->status = STATUS_OK;
+    unsigned int item_count = (unsigned int)load_le(payload + 4, 4);
+    if (item_count > MAX_BATCH_ITEMS) {
+        return -1;
+    }
+    cursor += 2 * sizeof(uint32_t);
+    
+    *items = (Response*)calloc(item_count ? item_count : 1, sizeof(Response));
+    if (!*items) {
+        return -1;
+    }
+    
+    for (unsigned int i = 0; i < item_count; i++) {
+        (*items)[i].version = batch->version;
+        if (decode_response_body(&cursor, end, &(*items)[i]) < 0) {
+            *count = i;
+            return -1;
+        }
+        *count = i + 1;
+    }
+    
+    return cursor == end ? 0 : -1;
+}
+
+int receive_batch_response(int sockfd, Response* batch, Response** items, int* count) {
+    *items = NULL;
+    *count = 0;
+    
+    if (batch->version >= 2) {
+        size_t length;
+        char* payload = receive_frame(sockfd, batch, &length);
+        if (!payload) {
+            return -1;
+        }
+        int result = decode_batch_response(payload, length, batch, items, count);
+        free(payload);
+        return result;
+    }
+    
+    if (batch->flags & REQUEST_FLAG_ID) {
+        if (read_exact(sockfd, &batch->request_id, sizeof(batch->request_id)) < 0) {
+            return -1;
+        }
+    }
+    
+    if (read_exact(sockfd, &batch->status, sizeof(batch->status)) < 0) {
+        return -1;
+    }
+    
+    if (batch->status != STATUS_OK) {
+        size_t error_len;
+        if (read_exact(sockfd, &error_len, sizeof(error_len)) < 0 || error_len > MAX_ERROR_MSG) {
+            return -1;
+        }
+        if (read_exact(sockfd, batch->error_message, error_len) < 0) {
+            return -1;
+        }
+        return 0;
+    }
+    
+    unsigned int item_count;
+    if (read_exact(sockfd, &item_count, sizeof(item_count)) < 0 || item_count > MAX_BATCH_ITEMS) {
+        return -1;
+    }
+    
+    *items = (Response*)calloc(item_count ? item_count : 1, sizeof(Response));
+    if (!*items) {
+        return -1;
+    }
+    
+    for (unsigned int i = 0; i < item_count; i++) {
+        (*items)[i].version = 1;
+        (*items)[i].flags = 0;
+        if (receive_response(sockfd, &(*items)[i]) < 0) {
+            *count = i;
+            return -1;
+        }
+    }
+    
+    *count = item_count;
     return 0;
 }
 
@@ -228,6 +832,19 @@ int send_admin_response(int sockfd, AdminResponse* resp) {
             return -1;
         }
         
+        // contoarele cache-ului, tot mereu prezente
+        if (write(sockfd, &resp->cache, sizeof(resp->cache)) < 0) {
+            return -1;
+        }
+        
+        if (write(sockfd, &resp->model, sizeof(resp->model)) < 0) {
+            return -1;
+        }
+        
+        if (write(sockfd, &resp->learner, sizeof(resp->learner)) < 0) {
+            return -1;
+        }
+        
         // daca avem clienti, trimitem informatiile despre ei
         if (resp->client_count > 0) {
             for (int i = 0; i < resp->client_count; i++) {
@@ -274,6 +891,18 @@ int receive_admin_response(int sockfd, AdminResponse* resp) {
             return -1;
         }
         
+        if (read_exact(sockfd, &resp->cache, sizeof(resp->cache)) < 0) {
+            return -1;
+        }
+        
+        if (read_exact(sockfd, &resp->model, sizeof(resp->model)) < 0) {
+            return -1;
+        }
+        
+        if (read_exact(sockfd, &resp->learner, sizeof(resp->learner)) < 0) {
+            return -1;
+        }
+        
         // daca avem clienti, primim informatiile despre ei
         if (resp->client_count > 0) {
             if (resp->client_count > MAX_CLIENTS) {
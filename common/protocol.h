@@ -1,16 +1,20 @@
 #ifndef PROTOCOL_H
 #define PROTOCOL_H
 
+#include <stdint.h>
 #include <time.h>
 
 #define MAX_TEXT_SIZE 65536
 #define MAX_ERROR_MSG 256
 #define MAX_CLIENTS 10
+#define MAX_BATCH_SIZE (4 * 1024 * 1024)
+#define MAX_BATCH_ITEMS 16384
 
 typedef enum {
     REQUEST_COUNT_WORDS = 1,
     REQUEST_DETERMINE_TOPIC = 2,
-    REQUEST_GENERATE_SUMMARY = 3
+    REQUEST_GENERATE_SUMMARY = 3,
+    REQUEST_BATCH = 5            // N perechi (tip, text) intr-un singur cadru; 4 e rezervat
 } RequestType;
 
 
@@ -20,12 +24,47 @@ typedef enum {
 } StatusCode;
 
 
+// Bit setat in campul type: dupa tip urmeaza un request_id, iar raspunsul
+// incepe cu acelasi id. Astfel clientul poate trimite mai multe cereri fara
+// sa astepte, iar raspunsurile pot sosi in alta ordine.
+#define REQUEST_FLAG_ID 0x100
+#define REQUEST_TYPE_MASK 0xff
+
+// Bit setat in campul type: cadrul e o bucata dintr-un document trimis in
+// flux (COUNT_WORDS, DETERMINE_TOPIC sau GENERATE_SUMMARY). Fiecare bucata
+// are cel mult MAX_TEXT_SIZE bytes, fara '\0'; o bucata de lungime 0 incheie
+// documentul si abia ea primeste raspuns. Documentul poate avea orice
+// lungime, iar pe o conexiune e deschis cel mult un flux.
+#define REQUEST_FLAG_STREAM 0x200
+
+// Formatul v2: fiecare cadru (cerere sau raspuns) incepe cu un antet fix
+// de FRAME_HEADER_SIZE bytes, little-endian indiferent de arhitectura:
+//   magic (uint32) | versiune (uint8) | tip (uint8) | flag-uri (uint16) |
+//   request_id (uint32) | lungimea payload-ului (uint64)
+// Flag-urile au aceleasi valori ca in v1; request_id e mereu prezent.
+// Serverul recunoaste cadrele v2 dupa magic (primii 4 bytes ai unei cereri
+// v1 sunt tipul, care nu poate arata asa), deci clientii v1 merg in
+// continuare, iar fiecare raspuns pleaca in versiunea cererii.
+#define PROTOCOL_MAGIC 0x76504c4eu   // "NLPv"
+#define PROTOCOL_VERSION 2
+#define FRAME_HEADER_SIZE 20
+// limita pentru payload-ul unui raspuns primit de client
+#define MAX_FRAME_SIZE (64 * 1024 * 1024)
+
+
 typedef struct {
+    int version;                // 1 sau PROTOCOL_VERSION
     RequestType type;
+    int flags;                  // REQUEST_FLAG_ID, REQUEST_FLAG_STREAM sau 0
+    unsigned int request_id;
     char text[MAX_TEXT_SIZE];
 } Request;
 
 typedef struct {
+    int version;                // ca la cerere; decide formatul raspunsului
+    RequestType type;           // tipul cererii, repetat in antetul v2
+    int flags;                  // copiate din cerere (in v1 decid daca se trimite request_id)
+    unsigned int request_id;
     StatusCode status;
     int word_count;
     char* topic;
@@ -37,7 +76,10 @@ typedef struct {
 
 typedef enum {
     ADMIN_GET_CLIENTS = 1,
-    ADMIN_GET_QUEUE_STATUS = 2
+    ADMIN_GET_QUEUE_STATUS = 2,
+    ADMIN_GET_CACHE_STATS = 3,
+    ADMIN_SAVE_MODEL = 4,
+    ADMIN_GET_LEARNER_STATS = 5
 } AdminCommandType;
 
 
@@ -54,20 +96,107 @@ typedef struct {
 } ClientInfo;
 
 
+// Contoarele cache-ului de rezultate (capacity 0 = cache dezactivat)
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t invalidations;     // intrari gasite dupa o schimbare a modelului
+    uint64_t evictions;
+    uint64_t entries;
+    uint64_t bytes;
+    uint64_t capacity;
+} CacheStats;
+
+
+// Ultimul snapshot al modelului Bayes salvat de server (zero daca inca nu)
+typedef struct {
+    uint64_t vocabulary;        // cuvinte distincte
+    uint64_t documents;         // documente de antrenare
+    uint64_t bytes;             // dimensiunea fisierului
+    double seconds;             // durata salvarii
+} ModelStats;
+
+
+// Antrenarea in fundal a clasificatorului
+typedef struct {
+    uint64_t pending;           // documente primite, inca nepublicate in model
+    uint64_t applied;
+    uint64_t dropped;           // coada plina
+    uint64_t batches;           // versiuni publicate
+    double lag_seconds;         // varsta celui mai vechi document nepublicat
+    double updates_per_second;  // media ultimelor secunde
+} LearnerStats;
+
+
 typedef struct {
     StatusCode status;
     int client_count;
     ClientInfo clients[MAX_CLIENTS];
     int queue_size;
     int queue_capacity;
+    CacheStats cache;
+    ModelStats model;
+    LearnerStats learner;
     char error_message[MAX_ERROR_MSG];
 } AdminResponse;
 
 
+// Antetul unei cereri v1 pe fir: tipul (cu flag-uri), request_id daca e
+// cerut, apoi lungimea textului (cu '\0'). In v2 antetul are mereu
+// FRAME_HEADER_SIZE bytes, iar textul poate lipsi '\0'-ul final.
+#define REQUEST_HEADER_MIN_SIZE (sizeof(int) + sizeof(size_t))
+#define REQUEST_HEADER_ID_SIZE (sizeof(int) + sizeof(unsigned int) + sizeof(size_t))
+#define REQUEST_HEADER_MAX_SIZE FRAME_HEADER_SIZE
+
+typedef struct {
+    int version;                // 1, PROTOCOL_VERSION sau o versiune nesuportata
+    RequestType type;
+    int flags;
+    unsigned int request_id;
+    size_t text_length;
+} RequestHeader;
+
+// Un element dintr-un lot REQUEST_BATCH. Payload-ul lotului: numarul de
+// elemente (unsigned int), apoi pentru fiecare tipul (int), lungimea (size_t,
+// cu '\0') si textul. In v2 campurile sunt uint32/uint32/uint64 little-endian.
+typedef struct {
+    RequestType type;
+    const char* text;
+} BatchItem;
+
+
+// Cererile si raspunsurile pleaca fiecare ca un singur cadru (un writev),
+// in formatul dat de req->version / resp->version
 int send_request(int sockfd, Request* req);
+// O bucata dintr-un flux (req da versiunea, tipul, flag-urile si
+// request_id-ul); length 0 incheie documentul
+int send_stream_chunk(int sockfd, Request* req, const char* data, size_t length);
+// doar v1
 int receive_request(int sockfd, Request* req);
 int send_response(int sockfd, Response* resp);
+// resp->version si resp->flags trebuie sa fie cele ale cererii trimise. In
+// v2 antetul si payload-ul se citesc intregi, apoi se decodifica din memorie.
 int receive_response(int sockfd, Response* resp);
+
+// Variante pe buffere, pentru socket-uri neblocante
+// Dimensiunea antetului, dedusa din primii sizeof(int) bytes
+size_t request_header_size(const char* data);
+int decode_request_header(const char* data, RequestHeader* header);
+char* encode_response(Response* resp, size_t* length);
+
+// Loturi: req da versiunea, flag-urile si request_id-ul cadrului; batch->version
+// si batch->flags trebuie sa fie cele ale cererii. *items se elibereaza de apelant.
+char* encode_batch_request(BatchItem* items, int count, int version, size_t* length);
+// numarul de elemente declarat la inceputul payload-ului (0 daca lipseste)
+unsigned int batch_item_count(const char* payload, size_t length, int version);
+int decode_batch_request(const char* payload, size_t length, int version, BatchItem* items, int max_items);
+char* encode_batch_response(Response* batch, Response* items, int count, size_t* length);
+int send_batch_request(int sockfd, Request* req, BatchItem* items, int count);
+int receive_batch_response(int sockfd, Response* batch, Response** items, int* count);
+
+// Dezactiveaza algoritmul lui Nagle: cadrele mici pleaca imediat
+int enable_tcp_nodelay(int sockfd);
+
 int send_admin_request(int sockfd, AdminRequest* req);
 int receive_admin_request(int sockfd, AdminRequest* req);
 int send_admin_response(int sockfd, AdminResponse* resp);
@@ -0,0 +1,37 @@
+#ifndef STOPWORD_HASH_H
+#define STOPWORD_HASH_H
+
+/* Functia de hash comuna pentru generatorul tabelei de stopwords
+ * (tools/gen_stopwords.c) si pentru cautarea din nlp.c.
+ * Tabela generata este un hash perfect in doua niveluri: hash-ul
+ * cuvantului alege un bucket, iar deplasamentul bucket-ului alege
+ * slotul final, fara coliziuni. */
+
+typedef struct {
+    const char* word;
+    unsigned char length;
+    unsigned char languages;  // masca STOPWORDS_*
+} StopwordEntry;
+
+// FNV-1a peste bytes
+static inline unsigned int stopword_hash(const char* word, int length) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        hash ^= (unsigned char)word[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// slotul final pentru un hash si deplasamentul bucket-ului sau
+static inline unsigned int stopword_slot(unsigned int hash, unsigned int displacement, unsigned int mask) {
+    unsigned int h = hash ^ displacement;
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return h & mask;
+}
+
+#endif
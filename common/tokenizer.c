@@ -0,0 +1,190 @@
+#include "tokenizer.h"
+#include <string.h>
+
+const unsigned char char_class[256] = {
+    ['A' ... 'Z'] = CHAR_LETTER,
+    ['a' ... 'z'] = CHAR_LETTER,
+    ['0' ... '9'] = CHAR_DIGIT,
+    ['_'] = CHAR_DIGIT,
+    ['.'] = CHAR_TERMINATOR,
+    ['!'] = CHAR_TERMINATOR,
+    ['?'] = CHAR_TERMINATOR,
+    [' '] = CHAR_SPACE,
+    ['\t' ... '\r'] = CHAR_SPACE,
+    [0xC3] = 1 << CHAR_LEAD_SHIFT,
+    [0xC4] = 2 << CHAR_LEAD_SHIFT,
+    [0xC5] = 3 << CHAR_LEAD_SHIFT,
+    [0xC8] = 4 << CHAR_LEAD_SHIFT,
+};
+
+const unsigned char diacritic_table[4][64] = {
+    // 0xC3: Â â Î î
+    { [0x02] = DIACRITIC_A_CIRC, [0x22] = DIACRITIC_A_CIRC,
+      [0x0E] = DIACRITIC_I_CIRC, [0x2E] = DIACRITIC_I_CIRC },
+    // 0xC4: Ă ă
+    { [0x02] = DIACRITIC_A_BREVE, [0x03] = DIACRITIC_A_BREVE },
+    // 0xC5: Ş ş Ţ ţ (cu sedila)
+    { [0x1E] = DIACRITIC_S_COMMA, [0x1F] = DIACRITIC_S_COMMA,
+      [0x22] = DIACRITIC_T_COMMA, [0x23] = DIACRITIC_T_COMMA },
+    // 0xC8: Ș ș Ț ț
+    { [0x18] = DIACRITIC_S_COMMA, [0x19] = DIACRITIC_S_COMMA,
+      [0x1A] = DIACRITIC_T_COMMA, [0x1B] = DIACRITIC_T_COMMA },
+};
+
+// forma normalizata a fiecarei litere DIACRITIC_* si litera de baza
+static const struct {
+    unsigned char lead;
+    unsigned char next;
+    char base;
+} folded_letters[] = {
+    { 0, 0, 0 },
+    { 0xC4, 0x83, 'a' },    // ă
+    { 0xC3, 0xA2, 'a' },    // â
+    { 0xC3, 0xAE, 'i' },    // î
+    { 0xC8, 0x99, 's' },    // ș
+    { 0xC8, 0x9B, 't' },    // ț
+};
+
+// sfarsitul secventei de caractere de cuvant care incepe la i;
+// *letters devine 0 daca secventa contine cifre sau '_'
+static size_t skip_word_run(const unsigned char* text, size_t length, size_t i, int* letters) {
+    while (i < length) {
+        unsigned char cls = char_class[text[i]];
+        if (cls & CHAR_LETTER) {
+            i++;        // calea rapida: litera ASCII, fara decodare UTF-8
+        } else if (cls & CHAR_DIGIT) {
+            *letters = 0;
+            i++;
+        } else if (i + 1 < length && diacritic_letter(text[i], text[i + 1])) {
+            i += 2;
+        } else {
+            break;
+        }
+    }
+    return i;
+}
+
+// fara "etc", "cap", "gen", "lit", "no": incheie des si propozitii
+static const char* const abbreviations[] = {
+    "alin", "ap", "approx", "apr", "aprox", "art", "asist", "aug", "av", "bd", "bl",
+    "cca", "col", "conf", "cpt", "dec", "dl", "dna", "dr", "dra", "ed", "ex",
+    "feb", "fig", "ian", "inc", "ing", "jr", "jud", "lect", "lt", "ltd", "mr",
+    "mrs", "ms", "mun", "nov", "nr", "oct", "pag", "pct", "pp", "prof", "sc",
+    "sept", "sf", "sr", "st", "str", "tel", "vol", "vs",
+};
+
+#define MAX_ABBREVIATION_LENGTH 8
+
+int is_abbreviation(const char* word, int length) {
+    if (length == 1) {
+        return char_class[(unsigned char)word[0]] & CHAR_LETTER;
+    }
+    if (length > MAX_ABBREVIATION_LENGTH) {
+        return 0;
+    }
+    
+    char lower[MAX_ABBREVIATION_LENGTH];
+    for (int i = 0; i < length; i++) {
+        unsigned char c = word[i];
+        if (!(char_class[c] & CHAR_LETTER)) {
+            return 0;
+        }
+        lower[i] = c | 0x20;
+    }
+    
+    for (size_t i = 0; i < sizeof(abbreviations) / sizeof(abbreviations[0]); i++) {
+        if (strncmp(abbreviations[i], lower, length) == 0 && abbreviations[i][length] == '\0') {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int is_decimal_digit(unsigned char c) {
+    return c >= '0' && c <= '9';
+}
+
+int ends_sentence(const char* text, size_t length, size_t pos) {
+    const unsigned char* t = (const unsigned char*)text;
+    if (t[pos] != '.') {
+        return 1;
+    }
+    if (pos > 0 && is_decimal_digit(t[pos - 1])) {
+        return !(pos + 1 < length && is_decimal_digit(t[pos + 1]));
+    }
+    
+    // cuvantul lipit de '.', citit de la coada; ajung primii bytes peste limita
+    size_t start = pos;
+    while (start > 0 && pos - start <= MAX_ABBREVIATION_LENGTH) {
+        if (char_class[t[start - 1]] & (CHAR_LETTER | CHAR_DIGIT)) {
+            start--;
+        } else if (start >= 2 && diacritic_letter(t[start - 2], t[start - 1])) {
+            start -= 2;
+        } else {
+            break;
+        }
+    }
+    return start == pos || !is_abbreviation(text + start, pos - start);
+}
+
+TokenKind next_token(const char* text, size_t length, size_t* pos, size_t* start, int terminators) {
+    const unsigned char* t = (const unsigned char*)text;
+    size_t i = *pos;
+    
+    while (i < length) {
+        unsigned char cls = char_class[t[i]];
+    
+        if ((cls & (CHAR_LETTER | CHAR_DIGIT)) ||
+            (i + 1 < length && diacritic_letter(t[i], t[i + 1]))) {
+            size_t word_start = i;
+            int letters = 1;
+            i = skip_word_run(t, length, i, &letters);
+            if (letters) {
+                *start = word_start;
+                *pos = i;
+                return TOKEN_WORD;
+            }
+            continue;
+        }
+    
+        if ((cls & CHAR_TERMINATOR) && terminators) {
+            *start = i;
+            *pos = i + 1;
+            return TOKEN_TERMINATOR;
+        }
+        i++;
+    }
+    
+    *start = length;
+    *pos = length;
+    return TOKEN_NONE;
+}
+
+int fold_word(char* word, int length, int strip_diacritics) {
+    unsigned char* w = (unsigned char*)word;
+    int out = 0;
+    
+    for (int i = 0; i < length; i++) {
+        unsigned char c = w[i];
+        if (char_class[c] & CHAR_LETTER) {
+            w[out++] = c | 0x20;
+            continue;
+        }
+    
+        int letter = i + 1 < length ? diacritic_letter(c, w[i + 1]) : 0;
+        if (!letter) {
+            w[out++] = c;
+            continue;
+        }
+    
+        // scrierea ramane in urma citirii: out <= i
+        if (strip_diacritics) {
+            w[out++] = folded_letters[letter].base;
+        } else {
+            w[out++] = folded_letters[letter].lead;
+            w[out++] = folded_letters[letter].next;
+        }
+        i++;
+    }
+    return out;
+}
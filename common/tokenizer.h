@@ -0,0 +1,64 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stddef.h>
+
+/* Scanarea cuvintelor din text UTF-8, fara regex.
+ * Un cuvant e o secventa maximala de caractere de cuvant formata doar din
+ * litere: [A-Za-z] si literele romanesti ă â î ș ț (mari sau mici, inclusiv
+ * variantele cu sedila ş ţ). Cifrele si '_' sunt caractere de cuvant, dar
+ * secventele care le contin nu sunt cuvinte (ca \b[a-zA-Z]+\b). Orice alt
+ * byte >= 0x80 desparte cuvintele. */
+
+#define CHAR_LETTER 0x01        // [A-Za-z]
+#define CHAR_DIGIT 0x02         // [0-9_]
+#define CHAR_TERMINATOR 0x04    // [.!?]
+#define CHAR_SPACE 0x08         // [ \t\n\v\f\r]
+#define CHAR_LEAD_SHIFT 4       // bitii 4-6: primul byte al unei diacritice, 1..4
+
+// Clasa fiecarui byte (CHAR_*)
+extern const unsigned char char_class[256];
+
+// [primul byte][al doilea byte & 0x3F] -> litera (DIACRITIC_*), 0 = nu e litera
+extern const unsigned char diacritic_table[4][64];
+
+// literele romanesti, dupa normalizare (litere mici, virgula in loc de sedila)
+#define DIACRITIC_A_BREVE 1     // ă
+#define DIACRITIC_A_CIRC 2      // â
+#define DIACRITIC_I_CIRC 3      // î
+#define DIACRITIC_S_COMMA 4     // ș
+#define DIACRITIC_T_COMMA 5     // ț
+
+// Litera romaneasca codificata de perechea (lead, next), sau 0
+static inline int diacritic_letter(unsigned char lead, unsigned char next) {
+    int slot = char_class[lead] >> CHAR_LEAD_SHIFT;
+    if (slot == 0 || (next & 0xC0) != 0x80) {
+        return 0;
+    }
+    return diacritic_table[slot - 1][next & 0x3F];
+}
+
+typedef enum {
+    TOKEN_NONE,         // sfarsitul textului
+    TOKEN_WORD,
+    TOKEN_TERMINATOR    // un singur byte [.!?]
+} TokenKind;
+
+// Urmatorul cuvant din text[*pos..length), sau si terminatorii de propozitie
+// daca terminators e nenul. Tokenul gasit e text[*start..*pos).
+TokenKind next_token(const char* text, size_t length, size_t* pos, size_t* start, int terminators);
+
+// Cuvant dupa care '.' nu incheie propozitia: o singura litera ASCII
+// (initiale, "e.g.") sau o abreviere uzuala ("dr", "prof", "nr", ...)
+int is_abbreviation(const char* word, int length);
+
+// 1 daca terminatorul de la text[pos] incheie propozitia. Un '.' nu o
+// incheie intre doua cifre (3.14) sau dupa o abreviere (vezi is_abbreviation).
+int ends_sentence(const char* text, size_t length, size_t pos);
+
+// Normalizeaza un cuvant pe loc: litere mici (ASCII si romanesti), ş ţ -> ș ț;
+// cu strip_diacritics si ă â -> a, î -> i, ș -> s, ț -> t. Cuvantul poate
+// doar sa se scurteze; intoarce lungimea noua (fara terminator '\0').
+int fold_word(char* word, int length, int strip_diacritics);
+
+#endif
@@ -0,0 +1,232 @@
+#include "word_count.h"
+#include "tokenizer.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define HAVE_X86_KERNELS 1
+#endif
+
+// Textul se parcurge in blocuri de 64 de bytes, fiecare redus la doua masti
+// de biti (bitul i = byte-ul i): w pentru caracterele de cuvant ([A-Za-z0-9_]
+// si ambii bytes ai literelor romanesti) si d pentru cifre si '_' (d e inclus
+// in w). Variantele difera doar prin felul in care calculeaza mastile;
+// numararea e aceeasi, deci rezultatele sunt identice.
+#define BLOCK_SIZE 64
+
+typedef struct {
+    uint64_t word_carry;    // ultimul byte al blocului anterior e din w
+    uint64_t taint_carry;   // transportul adunarii w + d din blocul anterior
+    size_t runs;            // secvente din w incheiate
+    size_t tainted;         // dintre ele, cele care contin cifre sau '_'
+} ScanState;
+
+// Sfarsitul unei secvente din w e marcat de bitul de dupa ea: (w << 1) & ~w.
+// Adunand d la w, transportul pornit de o cifra traverseaza restul secventei
+// si se opreste exact pe acel bit, deci (w + d) & ~w marcheaza secventele
+// care nu sunt cuvinte. Transporturile trec de la un bloc la urmatorul.
+static inline void scan_block(ScanState* state, uint64_t w, uint64_t d) {
+    uint64_t ends = ((w << 1) | state->word_carry) & ~w;
+    
+    uint64_t sum = w + d;
+    uint64_t carry = sum < w;
+    uint64_t total = sum + state->taint_carry;
+    carry |= total < sum;
+    
+    state->runs += __builtin_popcountll(ends);
+    state->tainted += __builtin_popcountll(total & ~w);
+    state->word_carry = w >> 63;
+    state->taint_carry = carry;
+}
+
+// Bytes >= 0x80 sunt rari, asa ca se decid pe rand, dupa masca high: un
+// byte e din w daca formeaza o litera romaneasca cu vecinul sau. Primul si
+// al doilea byte al unei perechi nu se pot confunda, deci vecinul poate fi
+// si in blocul alaturat.
+static uint64_t diacritic_bits(const char* text, size_t length, size_t offset, uint64_t high) {
+    const unsigned char* t = (const unsigned char*)text;
+    uint64_t letters = 0;
+    while (high) {
+        int i = __builtin_ctzll(high);
+        high &= high - 1;
+    
+        size_t pos = offset + i;
+        if ((pos + 1 < length && diacritic_letter(t[pos], t[pos + 1])) ||
+            (pos > 0 && diacritic_letter(t[pos - 1], t[pos]))) {
+            letters |= 1ULL << i;
+        }
+    }
+    return letters;
+}
+
+static inline void classify_scalar(const unsigned char* block, uint64_t* w, uint64_t* d, uint64_t* high) {
+    uint64_t word = 0, other = 0, upper = 0;
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        unsigned char cls = char_class[block[i]];
+        word |= (uint64_t)((cls & (CHAR_LETTER | CHAR_DIGIT)) != 0) << i;
+        other |= (uint64_t)((cls & CHAR_DIGIT) != 0) << i;
+        upper |= (uint64_t)(block[i] >> 7) << i;
+    }
+    *w = word;
+    *d = other;
+    *high = upper;
+}
+
+// Ultimul bloc (incomplet) se completeaza cu zerouri, care nu sunt din w;
+// o secventa care ajunge la sfarsitul textului se incheie dupa el.
+static size_t finish_scan(ScanState* state, const char* text, size_t offset, size_t length) {
+    if (offset < length) {
+        unsigned char block[BLOCK_SIZE] = { 0 };
+        memcpy(block, text + offset, length - offset);
+        uint64_t w, d, high;
+        classify_scalar(block, &w, &d, &high);
+        if (high) {
+            w |= diacritic_bits(text, length, offset, high);
+        }
+        scan_block(state, w, d);
+    }
+    
+    state->runs += state->word_carry;
+    state->tainted += state->taint_carry;
+    return state->runs - state->tainted;
+}
+
+static size_t count_scalar(const char* text, size_t length) {
+    ScanState state = { 0, 0, 0, 0 };
+    size_t i = 0;
+    
+    for (; i + BLOCK_SIZE <= length; i += BLOCK_SIZE) {
+        uint64_t w, d, high;
+        classify_scalar((const unsigned char*)text + i, &w, &d, &high);
+        if (high) {
+            w |= diacritic_bits(text, length, i, high);
+        }
+        scan_block(&state, w, d);
+    }
+    return finish_scan(&state, text, i, length);
+}
+
+#ifdef HAVE_X86_KERNELS
+
+// Comparatiile SSE2/AVX2 pe bytes sunt cu semn, asa ca intervalele se
+// verifica deplasandu-le la inceputul domeniului: c - 'a' < 26 (fara semn)
+// devine (c - 'a' - 128) < -128 + 26 (cu semn).
+#define LETTER_BIAS ((char)(128 - 'a'))
+#define LETTER_LIMIT ((char)(-128 + 26))
+#define DIGIT_BIAS ((char)(128 - '0'))
+#define DIGIT_LIMIT ((char)(-128 + 10))
+
+static inline void classify_sse2(const char* block, uint64_t* w, uint64_t* d, uint64_t* high) {
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i letter_bias = _mm_set1_epi8(LETTER_BIAS);
+    const __m128i letter_limit = _mm_set1_epi8(LETTER_LIMIT);
+    const __m128i digit_bias = _mm_set1_epi8(DIGIT_BIAS);
+    const __m128i digit_limit = _mm_set1_epi8(DIGIT_LIMIT);
+    const __m128i underscore = _mm_set1_epi8('_');
+    
+    uint64_t word = 0, other = 0, upper = 0;
+    for (int k = 0; k < BLOCK_SIZE / 16; k++) {
+        __m128i c = _mm_loadu_si128((const __m128i*)(block + 16 * k));
+        __m128i letter = _mm_cmplt_epi8(_mm_add_epi8(_mm_or_si128(c, case_bit), letter_bias), letter_limit);
+        __m128i digit = _mm_or_si128(_mm_cmplt_epi8(_mm_add_epi8(c, digit_bias), digit_limit),
+                                     _mm_cmpeq_epi8(c, underscore));
+        word |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_or_si128(letter, digit)) << (16 * k);
+        other |= (uint64_t)(uint16_t)_mm_movemask_epi8(digit) << (16 * k);
+        upper |= (uint64_t)(uint16_t)_mm_movemask_epi8(c) << (16 * k);
+    }
+    *w = word;
+    *d = other;
+    *high = upper;
+}
+
+static size_t count_sse2(const char* text, size_t length) {
+    ScanState state = { 0, 0, 0, 0 };
+    size_t i = 0;
+    
+    for (; i + BLOCK_SIZE <= length; i += BLOCK_SIZE) {
+        uint64_t w, d, high;
+        classify_sse2(text + i, &w, &d, &high);
+        if (high) {
+            w |= diacritic_bits(text, length, i, high);
+        }
+        scan_block(&state, w, d);
+    }
+    return finish_scan(&state, text, i, length);
+}
+
+__attribute__((target("avx2,popcnt")))
+static inline void classify_avx2(const char* block, uint64_t* w, uint64_t* d, uint64_t* high) {
+    const __m256i case_bit = _mm256_set1_epi8(0x20);
+    const __m256i letter_bias = _mm256_set1_epi8(LETTER_BIAS);
+    const __m256i letter_limit = _mm256_set1_epi8(LETTER_LIMIT);
+    const __m256i digit_bias = _mm256_set1_epi8(DIGIT_BIAS);
+    const __m256i digit_limit = _mm256_set1_epi8(DIGIT_LIMIT);
+    const __m256i underscore = _mm256_set1_epi8('_');
+    
+    uint64_t word = 0, other = 0, upper = 0;
+    for (int k = 0; k < BLOCK_SIZE / 32; k++) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(block + 32 * k));
+        // a > b in loc de b < a: AVX2 are doar comparatia "mai mare"
+        __m256i letter = _mm256_cmpgt_epi8(letter_limit,
+                                           _mm256_add_epi8(_mm256_or_si256(c, case_bit), letter_bias));
+        __m256i digit = _mm256_or_si256(_mm256_cmpgt_epi8(digit_limit, _mm256_add_epi8(c, digit_bias)),
+                                        _mm256_cmpeq_epi8(c, underscore));
+        word |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(letter, digit)) << (32 * k);
+        other |= (uint64_t)(uint32_t)_mm256_movemask_epi8(digit) << (32 * k);
+        upper |= (uint64_t)(uint32_t)_mm256_movemask_epi8(c) << (32 * k);
+    }
+    *w = word;
+    *d = other;
+    *high = upper;
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t count_avx2(const char* text, size_t length) {
+    ScanState state = { 0, 0, 0, 0 };
+    size_t i = 0;
+    
+    for (; i + BLOCK_SIZE <= length; i += BLOCK_SIZE) {
+        uint64_t w, d, high;
+        classify_avx2(text + i, &w, &d, &high);
+        if (high) {
+            w |= diacritic_bits(text, length, i, high);
+        }
+        scan_block(&state, w, d);
+    }
+    return finish_scan(&state, text, i, length);
+}
+
+#endif
+
+WordCountKernel word_count_kernel(const char* name) {
+    if (strcmp(name, "scalar") == 0) {
+        return count_scalar;
+    }
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    if (strcmp(name, "sse2") == 0) {
+        return count_sse2;      // parte din x86-64
+    }
+    if (strcmp(name, "avx2") == 0) {
+        return __builtin_cpu_supports("avx2") ? count_avx2 : NULL;
+    }
+#endif
+    return NULL;
+}
+
+static WordCountKernel selected_kernel = NULL;
+static pthread_once_t kernel_once = PTHREAD_ONCE_INIT;
+
+static void select_kernel(void) {
+    const char* preferred[] = { "avx2", "sse2", "scalar" };
+    for (size_t i = 0; i < sizeof(preferred) / sizeof(preferred[0]) && !selected_kernel; i++) {
+        selected_kernel = word_count_kernel(preferred[i]);
+    }
+}
+
+size_t count_word_runs(const char* text, size_t length) {
+    pthread_once(&kernel_once, select_kernel);
+    return selected_kernel(text, length);
+}
@@ -0,0 +1,16 @@
+#ifndef WORD_COUNT_H
+#define WORD_COUNT_H
+
+#include <stddef.h>
+
+// Numara cuvintele din text[0..length), aceleasi ca next_token (vezi
+// tokenizer.h); pe text ASCII, exact potrivirile lui \b[a-zA-Z]+\b.
+// Varianta (AVX2, SSE2 sau scalara) se alege o data, dupa procesor.
+size_t count_word_runs(const char* text, size_t length);
+
+// Variantele, pentru benchmark si verificare: "scalar", "sse2" sau "avx2";
+// NULL daca varianta nu exista in build sau procesorul nu o suporta
+typedef size_t (*WordCountKernel)(const char* text, size_t length);
+WordCountKernel word_count_kernel(const char* name);
+
+#endif
@@ -13,6 +13,20 @@ MAX_TEXT_SIZE = 65536
 REQUEST_COUNT_WORDS = 1
 REQUEST_DETERMINE_TOPIC = 2
 REQUEST_GENERATE_SUMMARY = 3
+REQUEST_BATCH = 5
+
+MAX_BATCH_SIZE = 4 * 1024 * 1024
+
+# cererea poarta un request_id, repetat la inceputul raspunsului (v1)
+REQUEST_FLAG_ID = 0x100
+# cadrul e o bucata dintr-un document trimis in flux; o bucata goala il incheie
+REQUEST_FLAG_STREAM = 0x200
+
+# Formatul v2: antet fix little-endian, identic pe orice arhitectura:
+# magic, versiune, tip, flag-uri, request_id, lungimea payload-ului
+PROTOCOL_MAGIC = 0x76504c4e
+PROTOCOL_VERSION = 2
+FRAME_HEADER = struct.Struct('<IBBHIQ')
 
 
 STATUS_OK = 0
@@ -29,6 +43,8 @@ class NLPClient:
         try:
             self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
             self.sock.connect((self.server_ip, self.port))
+            # fiecare cadru pleacă dintr-un singur sendall: fără Nagle
+            self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
             print(f" Conectat la serverul NLP pe {self.server_ip}:{self.port}")
             return True
         except Exception as e:
@@ -42,53 +58,110 @@ class NLPClient:
             self.sock = None
             print(" Deconectat de la server")
     
-    def send_request(self, request_type, text):
-        """Trimite cerere către server"""
+    def send_frame(self, request_type, payload, request_id=None, flags=0):
+        """Trimite un cadru v2: antetul fix și payload-ul într-un singur sendall"""
         if not self.sock:
             raise Exception("Nu sunt conectat la server")
         
-        self.sock.send(struct.pack('<i', request_type))
+        header = FRAME_HEADER.pack(PROTOCOL_MAGIC, PROTOCOL_VERSION, request_type, flags,
+                                   request_id or 0, len(payload))
+        self.sock.sendall(header + payload)
+    
+    def send_request(self, request_type, text, request_id=None):
+        """Trimite cerere către server (cu request_id, dacă e dat)"""
+        self.send_frame(request_type, text.encode('utf-8'), request_id)
+    
+    def send_stream(self, request_type, data, request_id=None):
+        """Trimite un document oricât de mare în bucăți de cel mult MAX_TEXT_SIZE"""
+        for offset in range(0, len(data), MAX_TEXT_SIZE):
+            chunk = data[offset:offset + MAX_TEXT_SIZE]
+            self.send_frame(request_type, chunk, request_id, REQUEST_FLAG_STREAM)
         
-        text_bytes = text.encode('utf-8') + b'\0'
+        # o bucată goală încheie documentul
+        self.send_frame(request_type, b'', request_id, REQUEST_FLAG_STREAM)
+    
+    def send_document(self, request_type, text, request_id=None):
+        """Textele mai mari decât o cerere pleacă în flux"""
+        data = text.encode('utf-8')
+        if len(data) >= MAX_TEXT_SIZE:
+            self.send_stream(request_type, data, request_id)
+        else:
+            self.send_request(request_type, text, request_id)
+    
+    def send_batch(self, items, request_id=None):
+        """Trimite un lot de perechi (tip cerere, text) într-un singur cadru"""
+        payload = [struct.pack('<I', len(items))]
+        for request_type, text in items:
+            text_bytes = text.encode('utf-8') + b'\0'
+            payload.append(struct.pack('<IQ', request_type, len(text_bytes)))
+            payload.append(text_bytes)
+        payload = b''.join(payload)
         
-        self.sock.send(struct.pack('<Q', len(text_bytes)))
+        if len(payload) > MAX_BATCH_SIZE:
+            raise Exception(f"Lotul este prea mare, maxim {MAX_BATCH_SIZE} bytes permis")
         
-        self.sock.send(text_bytes)
+        self.send_frame(REQUEST_BATCH, payload, request_id)
     
-    def receive_response(self):
-        """Primește răspuns de la server"""
+    def receive_frame(self):
+        """Primește un cadru v2 întreg: (request_id, payload)"""
         if not self.sock:
             raise Exception("Nu sunt conectat la server")
         
-        status_data = self._recv_exact(4)
-        status = struct.unpack('<i', status_data)[0]
+        magic, version, _, _, request_id, length = FRAME_HEADER.unpack(
+            self._recv_exact(FRAME_HEADER.size))
+        if magic != PROTOCOL_MAGIC or version != PROTOCOL_VERSION:
+            raise Exception(f"Cadru invalid (versiunea {version})")
+        
+        return request_id, self._recv_exact(length)
+    
+    def receive_batch_response(self):
+        """Primește răspunsul la un lot: câte un rezultat pentru fiecare element"""
+        request_id, payload = self.receive_frame()
+        
+        status = struct.unpack_from('<I', payload)[0]
+        if status != STATUS_OK:
+            response, _ = self._parse_response(payload, 0)
+            response['request_id'] = request_id
+            return response
+        
+        count = struct.unpack_from('<I', payload, 4)[0]
+        offset = 8
+        items = []
+        for _ in range(count):
+            item, offset = self._parse_response(payload, offset)
+            items.append(item)
+        
+        return {
+            'request_id': request_id,
+            'status': 'OK',
+            'items': items
+        }
+    
+    def receive_response(self):
+        """Primește răspuns de la server"""
+        request_id, payload = self.receive_frame()
+        
+        response, _ = self._parse_response(payload, 0)
+        response['request_id'] = request_id
+        return response
+    
+    def _parse_string(self, payload, offset):
+        length = struct.unpack_from('<Q', payload, offset)[0]
+        offset += 8
+        if length == 0:
+            return None, offset
+        return payload[offset:offset + length].decode('utf-8'), offset + length
+    
+    def _parse_response(self, payload, offset):
+        """Decodifică un răspuns din payload; întoarce (răspuns, offset-ul următor)"""
+        status = struct.unpack_from('<I', payload, offset)[0]
+        offset += 4
         
         if status == STATUS_OK:
-            
-            word_count_data = self._recv_exact(4)
-            word_count = struct.unpack('<i', word_count_data)[0]
-            
-            
-            time_data = self._recv_exact(8)
-            processing_time = struct.unpack('<d', time_data)[0]
-            
-            
-            topic_len_data = self._recv_exact(8)
-            topic_len = struct.unpack('<Q', topic_len_data)[0]
-            
-            topic = None
-            if topic_len > 0:
-                topic_data = self._recv_exact(topic_len)
-                topic = topic_data.decode('utf-8').rstrip('\0')
-            
-            
-            summary_len_data = self._recv_exact(8)
-            summary_len = struct.unpack('<Q', summary_len_data)[0]
-            
-            summary = None
-            if summary_len > 0:
-                summary_data = self._recv_exact(summary_len)
-                summary = summary_data.decode('utf-8').rstrip('\0')
+            word_count, processing_time = struct.unpack_from('<id', payload, offset)
+            offset += 12
+            topic, offset = self._parse_string(payload, offset)
+            summary, offset = self._parse_string(payload, offset)
             
             return {
                 'status': 'OK',
@@ -96,61 +169,36 @@ class NLPClient:
                 'processing_time': processing_time,
                 'topic': topic,
                 'summary': summary
-            }
+            }, offset
         else:
-            
-            error_len_data = self._recv_exact(8)
-            error_len = struct.unpack('<Q', error_len_data)[0]
-            
-            error_data = self._recv_exact(error_len)
-            error_msg = error_data.decode('utf-8').rstrip('\0')
+            error_msg, offset = self._parse_string(payload, offset)
             
             return {
                 'status': 'ERROR',
-                'error': error_msg
-            }
+                'error': error_msg or ''
+            }, offset
     
     def _recv_exact(self, size):
         """Primește exact `size` bytes"""
-        data = b''
-        while len(data) < size:
-            chunk = self.sock.recv(size - len(data))
+        chunks = []
+        while size > 0:
+            chunk = self.sock.recv(min(size, 1 << 20))
             if not chunk:
                 raise Exception("Conexiunea s-a închis neașteptat")
-            data += chunk
-        return data
+            chunks.append(chunk)
+            size -= len(chunk)
+        return b''.join(chunks)
     
     def process_file(self, command, filename):
         """Procesează un fișier cu comanda specificată"""
         
-        command_map = {
-            '--count-words': REQUEST_COUNT_WORDS,
-            '--determine-topic': REQUEST_DETERMINE_TOPIC,
-            '--generate-summary': REQUEST_GENERATE_SUMMARY
-        }
-        
-        if command not in command_map:
-            return None, f"Comandă necunoscută: {command}"
-        
-        request_type = command_map[command]
-        
-        
-        try:
-            with open(filename, 'r', encoding='utf-8') as f:
-                text = f.read()
-            
-            if len(text) > MAX_TEXT_SIZE:
-                return None, f"Fișierul este prea mare, maxim {MAX_TEXT_SIZE} bytes permis"
-        
-        except FileNotFoundError:
-            return None, f"Fișierul {filename} nu a fost găsit"
-        except Exception as e:
-            return None, f"Eroare la citirea fișierului: {e}"
-        
+        request_type, text, error = read_request(command, filename)
+        if error:
+            return None, error
         
         try:
             print(f"📤 Trimit cererea: {command} pentru {filename}")
-            self.send_request(request_type, text)
+            self.send_document(request_type, text)
             
             print("⏳ Aștept răspunsul de la server...")
             response = self.receive_response()
@@ -159,13 +207,96 @@ class NLPClient:
             
         except Exception as e:
             return None, f"Eroare de comunicare: {e}"
+    
+    def process_files(self, command, filenames):
+        """Trimite toate cererile fără să aștepte, apoi colectează răspunsurile
+        după request_id (serverul le poate termina în orice ordine)"""
+        
+        results = [(None, None)] * len(filenames)
+        pending = 0
+        
+        try:
+            for request_id, filename in enumerate(filenames):
+                request_type, text, error = read_request(command, filename)
+                if error:
+                    results[request_id] = (None, error)
+                    continue
+                
+                self.send_document(request_type, text, request_id)
+                pending += 1
+            
+            print(f"📤 Trimise {pending} cereri: {command}")
+            
+            for _ in range(pending):
+                response = self.receive_response()
+                results[response['request_id']] = (response, None)
+            
+        except Exception as e:
+            return [(None, f"Eroare de comunicare: {e}")] * len(filenames)
+        
+        return results
+    
+    def process_batch(self, command, filenames):
+        """Trimite toate fișierele ca un singur lot (un cadru în fiecare sens)"""
+        
+        results = [(None, None)] * len(filenames)
+        items = []
+        positions = []
+        
+        for index, filename in enumerate(filenames):
+            request_type, text, error = read_request(command, filename)
+            if not error and len(text.encode('utf-8')) >= MAX_TEXT_SIZE:
+                error = f"Fișierul este prea mare pentru un lot, maxim {MAX_TEXT_SIZE} bytes permis"
+            if error:
+                results[index] = (None, error)
+            else:
+                items.append((request_type, text))
+                positions.append(index)
+        
+        try:
+            print(f"📤 Trimit un lot de {len(items)} documente: {command}")
+            self.send_batch(items)
+            response = self.receive_batch_response()
+        except Exception as e:
+            return [(None, f"Eroare de comunicare: {e}")] * len(filenames)
+        
+        if response['status'] != 'OK':
+            return [(None, f"Eroare de la server: {response['error']}")] * len(filenames)
+        
+        for index, item in zip(positions, response['items']):
+            results[index] = (item, None)
+        
+        return results
+
+def read_request(command, filename):
+    """Întoarce (tip cerere, text, eroare) pentru un fișier"""
+    
+    command_map = {
+        '--count-words': REQUEST_COUNT_WORDS,
+        '--determine-topic': REQUEST_DETERMINE_TOPIC,
+        '--generate-summary': REQUEST_GENERATE_SUMMARY
+    }
+    
+    if command not in command_map:
+        return None, None, f"Comandă necunoscută: {command}"
+    
+    try:
+        with open(filename, 'r', encoding='utf-8') as f:
+            text = f.read()
+    
+    except FileNotFoundError:
+        return None, None, f"Fișierul {filename} nu a fost găsit"
+    except Exception as e:
+        return None, None, f"Eroare la citirea fișierului: {e}"
+    
+    return command_map[command], text, None
 
 def print_help():
     """Afișează mesajul de ajutor"""
     print("=" * 60)
     print("CLIENT PYTHON PENTRU SERVERUL NLP")
     print("=" * 60)
-    print("Utilizare: python3 nlp_client.py COMANDA FIȘIER")
+    print("Utilizare: python3 nlp_client.py COMANDA [--batch] FIȘIER [FIȘIER...]")
     print("\nComenzi disponibile:")
     print("  --count-words FIȘIER        Numără cuvintele din fișier")
     print("  --determine-topic FIȘIER    Determină domeniul tematic")
@@ -174,6 +305,10 @@ def print_help():
     print("  python3 nlp_client.py --count-words ../resources/test.txt")
     print("  python3 nlp_client.py --determine-topic ../resources/test_sport.txt")
     print("  python3 nlp_client.py --generate-summary ../resources/test_lung.txt")
+    print("\nCu mai multe fișiere, cererile pleacă pe aceeași conexiune fără")
+    print("a aștepta fiecare răspuns (pipelining); cu --batch pleacă toate într-un")
+    print("singur cadru și revin într-un singur răspuns.")
+    print("Fișierele mai mari de 64 KB se trimit în flux, pe bucăți (nu și în loturi).")
 
 def print_response(command, response):
     """Afișează răspunsul în format frumos"""
@@ -195,12 +330,18 @@ def print_response(command, response):
     print("=" * 60)
 
 def main():
-    if len(sys.argv) != 3:
+    if len(sys.argv) < 3:
         print_help()
         return 1
     
     command = sys.argv[1]
-    filename = sys.argv[2]
+    filenames = sys.argv[2:]
+    batch = filenames[0] == '--batch'
+    if batch:
+        filenames = filenames[1:]
+        if not filenames:
+            print_help()
+            return 1
     
     print(" Inițializare client Python NLP...")
     
@@ -211,23 +352,35 @@ def main():
     if not client.connect():
         return 1
     
+    failed = False
     try:
         
-        response, error = client.process_file(command, filename)
-        
-        if error:
-            print(f"✗ Eroare: {error}")
-            return 1
-        
-        if response['status'] == 'OK':
-            print_response(command, response)
+        if batch:
+            results = client.process_batch(command, filenames)
+        elif len(filenames) == 1:
+            results = [client.process_file(command, filenames[0])]
         else:
-            print(f"✗ Eroare de la server: {response['error']}")
-            return 1
+            results = client.process_files(command, filenames)
+        
+        for filename, (response, error) in zip(filenames, results):
+            if len(filenames) > 1 or batch:
+                print(f"\n {filename}")
+            
+            if error:
+                print(f"✗ Eroare: {error}")
+                failed = True
+            elif response['status'] == 'OK':
+                print_response(command, response)
+            else:
+                print(f"✗ Eroare de la server: {response['error']}")
+                failed = True
             
     finally:
         client.disconnect()
     
+    if failed:
+        return 1
+    
     print(" Procesare completă!")
     return 0
 
@@ -0,0 +1,101 @@
+#include "buffer_pool.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+// Clase de marime puteri ale lui 2, de la 256 B la 64 KB (MAX_TEXT_SIZE).
+// Loturile mai mari se aloca si se elibereaza direct.
+#define MIN_CLASS_SHIFT 8
+#define MAX_CLASS_SHIFT 16
+#define CLASS_COUNT (MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1)
+
+// cate buffere libere pastram pe clasa
+#define MAX_FREE_PER_CLASS 64
+
+typedef struct {
+    pthread_mutex_t lock;
+    Buffer* free_list;
+    int free_count;
+} SizeClass;
+
+static SizeClass classes[CLASS_COUNT];
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+
+static void init_pool(void) {
+    for (int i = 0; i < CLASS_COUNT; i++) {
+        pthread_mutex_init(&classes[i].lock, NULL);
+        classes[i].free_list = NULL;
+        classes[i].free_count = 0;
+    }
+}
+
+// -1 daca dimensiunea depaseste cea mai mare clasa
+static int size_class(size_t size) {
+    int shift = MIN_CLASS_SHIFT;
+    while (((size_t)1 << shift) < size) {
+        shift++;
+        if (shift > MAX_CLASS_SHIFT) {
+            return -1;
+        }
+    }
+    return shift - MIN_CLASS_SHIFT;
+}
+
+Buffer* buffer_acquire(size_t length) {
+    pthread_once(&pool_once, init_pool);
+    
+    int index = size_class(length + 1);
+    Buffer* buffer = NULL;
+    
+    if (index >= 0) {
+        SizeClass* class = &classes[index];
+        pthread_mutex_lock(&class->lock);
+        buffer = class->free_list;
+        if (buffer) {
+            class->free_list = buffer->next;
+            class->free_count--;
+        }
+        pthread_mutex_unlock(&class->lock);
+    }
+    
+    if (!buffer) {
+        size_t capacity = index >= 0 ? (size_t)1 << (index + MIN_CLASS_SHIFT) : length + 1;
+        buffer = (Buffer*)malloc(sizeof(Buffer) + capacity);
+        if (!buffer) {
+            return NULL;
+        }
+        buffer->capacity = capacity;
+    }
+    
+    atomic_init(&buffer->refs, 1);
+    buffer->length = length;
+    buffer->next = NULL;
+    buffer->data[length] = '\0';
+    return buffer;
+}
+
+void buffer_retain(Buffer* buffer) {
+    atomic_fetch_add_explicit(&buffer->refs, 1, memory_order_relaxed);
+}
+
+void buffer_release(Buffer* buffer) {
+    if (!buffer) return;
+    
+    if (atomic_fetch_sub_explicit(&buffer->refs, 1, memory_order_acq_rel) != 1) {
+        return;
+    }
+    
+    int index = size_class(buffer->capacity);
+    if (index >= 0 && ((size_t)1 << (index + MIN_CLASS_SHIFT)) == buffer->capacity) {
+        SizeClass* class = &classes[index];
+        pthread_mutex_lock(&class->lock);
+        if (class->free_count < MAX_FREE_PER_CLASS) {
+            buffer->next = class->free_list;
+            class->free_list = buffer;
+            class->free_count++;
+            buffer = NULL;
+        }
+        pthread_mutex_unlock(&class->lock);
+    }
+    
+    free(buffer);
+}
@@ -0,0 +1,24 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+// Buffer cu contor de referinte pentru textul unei cereri. Reactorul il
+// umple direct din socket, iar coada si thread-ul de procesare il folosesc
+// fara copii. Ultimul buffer_release il intoarce in pool.
+typedef struct Buffer {
+    atomic_int refs;
+    size_t length;              // bytes utili (fara '\0'-ul adaugat la final)
+    size_t capacity;            // clasa de marime din pool
+    struct Buffer* next;        // lista de buffere libere sau bucatile unui flux
+    char data[];
+} Buffer;
+
+// Buffer de cel putin length + 1 bytes (data[length] e rezervat pentru '\0'),
+// cu o singura referinta; NULL la eroare de alocare
+Buffer* buffer_acquire(size_t length);
+void buffer_retain(Buffer* buffer);
+void buffer_release(Buffer* buffer);
+
+#endif
@@ -0,0 +1,206 @@
+#include "connection.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#define INITIAL_OUTPUT_CAPACITY 4096
+
+Connection* create_connection(int fd) {
+    Connection* conn = (Connection*)calloc(1, sizeof(Connection));
+    if (!conn) {
+        return NULL;
+    }
+    
+    conn->fd = fd;
+    return conn;
+}
+
+void free_connection(Connection* conn) {
+    if (!conn) return;
+    
+    buffer_release(conn->text);
+    free(conn->output);
+    free(conn);
+}
+
+static int complete_request(Connection* conn, RequestHandler handler) {
+    if (conn->text_received < conn->request.text_length) {
+        return 0;
+    }
+    
+    Buffer* text = conn->text;
+    conn->text = NULL;
+    conn->header_received = 0;
+    return handler(conn, &conn->request, text);
+}
+
+// Consuma bytes din data; intoarce cati au fost folositi sau -1 la antet invalid
+static long consume(Connection* conn, const char* data, size_t length, RequestHandler handler) {
+    size_t used = 0;
+    
+    if (conn->text == NULL) {
+        // primii 4 bytes (magic-ul v2 sau tipul v1, care spune daca urmeaza
+        // request_id) dau lungimea antetului
+        size_t header_size = conn->header_received < sizeof(int)
+                           ? sizeof(int) : request_header_size(conn->header);
+        size_t needed = header_size - conn->header_received;
+        size_t chunk = length < needed ? length : needed;
+        memcpy(conn->header + conn->header_received, data, chunk);
+        conn->header_received += chunk;
+        used += chunk;
+        
+        if (conn->header_received < sizeof(int) ||
+            conn->header_received < request_header_size(conn->header)) {
+            return used;
+        }
+        
+        if (decode_request_header(conn->header, &conn->request) < 0) {
+            return -1;
+        }
+        
+        // buffer-ul are mereu loc pentru '\0', chiar daca clientul nu l-a trimis
+        conn->text = buffer_acquire(conn->request.text_length);
+        if (!conn->text) {
+            return -1;
+        }
+        conn->text_received = 0;
+    }
+    
+    size_t needed = conn->request.text_length - conn->text_received;
+    size_t chunk = length - used < needed ? length - used : needed;
+    memcpy(conn->text->data + conn->text_received, data + used, chunk);
+    conn->text_received += chunk;
+    used += chunk;
+    
+    if (complete_request(conn, handler) < 0) {
+        return -1;
+    }
+    return used;
+}
+
+int connection_read(Connection* conn, char* scratch, size_t scratch_size, RequestHandler handler) {
+    while (!conn->paused) {
+        // restul unui text inceput se citeste direct in buffer-ul cererii;
+        // antetele (si cererile mici, intregi) trec prin scratch
+        int direct = conn->text != NULL;
+        char* target = direct ? conn->text->data + conn->text_received : scratch;
+        size_t size = direct ? conn->request.text_length - conn->text_received : scratch_size;
+        
+        ssize_t received = read(conn->fd, target, size);
+    
+        if (received == 0) {
+            return -1;
+        }
+        if (received < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            return -1;
+        }
+        
+        if (direct) {
+            conn->text_received += received;
+            if (complete_request(conn, handler) < 0) {
+                return -1;
+            }
+            continue;
+        }
+        
+        // cererile deja citite in scratch se predau chiar daca intre timp
+        // conexiunea a fost pusa pe pauza
+        size_t offset = 0;
+        while (offset < (size_t)received) {
+            long used = consume(conn, scratch + offset, received - offset, handler);
+            if (used < 0) {
+                return -1;
+            }
+            offset += used;
+        }
+    }
+    
+    return 0;
+}
+
+int connection_flush(Connection* conn) {
+    while (conn->output_sent < conn->output_length) {
+        ssize_t sent = send(conn->fd, conn->output + conn->output_sent,
+                            conn->output_length - conn->output_sent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            return -1;
+        }
+        conn->output_sent += sent;
+    }
+    
+    // conexiunile inactive nu pastreaza buffer-e
+    free(conn->output);
+    conn->output = NULL;
+    conn->output_capacity = 0;
+    conn->output_length = 0;
+    conn->output_sent = 0;
+    return 0;
+}
+
+// Trimite direct din data cand nu e nimic in asteptare; intoarce cat s-a trimis sau -1
+static long send_direct(Connection* conn, const char* data, size_t length) {
+    size_t sent_total = 0;
+    
+    while (sent_total < length) {
+        ssize_t sent = send(conn->fd, data + sent_total, length - sent_total, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return -1;
+        }
+        sent_total += sent;
+    }
+    
+    return sent_total;
+}
+
+int connection_send(Connection* conn, const char* data, size_t length) {
+    if (conn->output_length == 0) {
+        long sent = send_direct(conn, data, length);
+        if (sent < 0) {
+            return -1;
+        }
+        data += sent;
+        length -= sent;
+        if (length == 0) {
+            return 0;
+        }
+    }
+    
+    size_t required = conn->output_length + length;
+    
+    if (required > conn->output_capacity) {
+        // mutam la inceput ce a ramas netrimis inainte sa crestem buffer-ul
+        if (conn->output_sent > 0) {
+            memmove(conn->output, conn->output + conn->output_sent, conn->output_length - conn->output_sent);
+            conn->output_length -= conn->output_sent;
+            conn->output_sent = 0;
+            required = conn->output_length + length;
+        }
+    
+        if (required > conn->output_capacity) {
+            size_t capacity = conn->output_capacity ? conn->output_capacity : INITIAL_OUTPUT_CAPACITY;
+            while (capacity < required) {
+                capacity *= 2;
+            }
+    
+            char* output = (char*)realloc(conn->output, capacity);
+            if (!output) {
+                return -1;
+            }
+            conn->output = output;
+            conn->output_capacity = capacity;
+        }
+    }
+    
+    // restul pleaca la urmatorul EPOLLOUT
+    memcpy(conn->output + conn->output_length, data, length);
+    conn->output_length += length;
+    return 0;
+}
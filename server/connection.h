@@ -0,0 +1,54 @@
+#ifndef CONNECTION_H
+#define CONNECTION_H
+
+#include <stddef.h>
+#include "../common/protocol.h"
+#include "buffer_pool.h"
+
+// Starea unei conexiuni TCP neblocante, folosita doar de thread-ul reactor.
+// Cererile se asambleaza din bucati pe masura ce sosesc, iar raspunsurile
+// asteapta in output pana cand socket-ul accepta date.
+typedef struct {
+    int fd;
+    
+    // cererea curenta: antetul, apoi textul (buffer din pool, lungime exacta)
+    char header[REQUEST_HEADER_MAX_SIZE];
+    size_t header_received;
+    RequestHeader request;
+    Buffer* text;
+    size_t text_received;
+    
+    // raspunsuri netrimise inca
+    char* output;
+    size_t output_length;
+    size_t output_sent;
+    size_t output_capacity;
+    
+    int pending;   // cereri aflate la procesare
+    int closing;   // clientul s-a deconectat; fd-ul se inchide cand pending ajunge la 0
+    
+    // documentul trimis in flux (REQUEST_FLAG_STREAM), daca exista unul deschis
+    struct TextStream* stream;
+    int queued_chunks;   // bucati din flux aflate la procesare
+    int paused;          // citirea asteapta sa scada queued_chunks, pending sau output
+} Connection;
+
+// Apelat pentru fiecare cerere completa; primeste referinta la text.
+// Intoarce -1 daca cererea nu e valida in starea conexiunii.
+typedef int (*RequestHandler)(Connection* conn, const RequestHeader* request, Buffer* text);
+
+Connection* create_connection(int fd);
+void free_connection(Connection* conn);
+
+// Citeste tot ce e disponibil (pana la EAGAIN sau pana cand conexiunea e
+// pusa pe pauza) folosind buffer-ul scratch. Intoarce -1 la deconectare sau
+// cerere invalida.
+int connection_read(Connection* conn, char* scratch, size_t scratch_size, RequestHandler handler);
+
+// Adauga un raspuns in output si incearca sa-l trimita; -1 la eroare
+int connection_send(Connection* conn, const char* data, size_t length);
+
+// Trimite cat se poate din output (pana la EAGAIN); -1 la eroare
+int connection_flush(Connection* conn);
+
+#endif
@@ -0,0 +1,306 @@
+#include "learner.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CACHE_LINE 64
+
+// documente aplicate intr-un lot (si deci intr-o generatie), cel mult
+#define MAX_BATCH 256
+
+// rata de aplicare e media ultimelor RATE_WINDOW secunde
+#define RATE_WINDOW 10
+
+// cate incercari cu sched_yield inainte de a dormi, asteptand cititorii
+#define DRAIN_SPINS 64
+#define DRAIN_SLEEP_NS 50000
+
+typedef struct PendingUpdate {
+    struct PendingUpdate* next;
+    double received_at;
+    TrainingExample* example;
+} PendingUpdate;
+
+typedef struct {
+    BayesClassifier* classifier;
+    _Alignas(CACHE_LINE) atomic_int readers;
+} ModelCopy;
+
+struct Learner {
+    ModelCopy copies[2];
+    _Alignas(CACHE_LINE) atomic_int current;    // copia publicata
+    _Atomic uint64_t generation;
+    _Atomic uint64_t documents;         // aplicate in copia publicata
+    
+    _Alignas(CACHE_LINE) pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    PendingUpdate* head;
+    PendingUpdate* tail;
+    int queued;
+    int max_pending;
+    int in_flight;              // lotul in curs de aplicare
+    double in_flight_since;     // received_at al primului document din lot
+    int stop;
+    
+    uint64_t applied;
+    uint64_t dropped;
+    uint64_t batches;
+    uint64_t rate_counts[RATE_WINDOW];
+    long rate_seconds[RATE_WINDOW];
+    
+    pthread_t thread;
+};
+
+static double monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+BayesClassifier* learner_acquire(Learner* learner, int* copy) {
+    while (1) {
+        int index = atomic_load(&learner->current);
+        atomic_fetch_add(&learner->copies[index].readers, 1);
+        // daca intre timp s-a publicat cealalta copie, thread-ul de fundal
+        // poate sa nu ne fi vazut; o luam de la capat
+        if (atomic_load(&learner->current) == index) {
+            *copy = index;
+            return learner->copies[index].classifier;
+        }
+        atomic_fetch_sub(&learner->copies[index].readers, 1);
+    }
+}
+
+void learner_release(Learner* learner, int copy) {
+    atomic_fetch_sub(&learner->copies[copy].readers, 1);
+}
+
+uint64_t learner_generation(Learner* learner) {
+    return atomic_load(&learner->generation);
+}
+
+uint64_t learner_documents(Learner* learner) {
+    return atomic_load(&learner->documents);
+}
+
+// 1 daca documentul trebuie renuntat din cauza cozii pline
+static int reject_if_full(Learner* learner) {
+    pthread_mutex_lock(&learner->mutex);
+    int full = learner->queued >= learner->max_pending;
+    if (full) {
+        learner->dropped++;
+    }
+    pthread_mutex_unlock(&learner->mutex);
+    return full;
+}
+
+// Preia example; NULL (o copiere esuata) se numara ca document renuntat
+static int enqueue_example(Learner* learner, TrainingExample* example) {
+    PendingUpdate* update = example ? (PendingUpdate*)malloc(sizeof(PendingUpdate)) : NULL;
+    if (!update) {
+        free(example);
+        pthread_mutex_lock(&learner->mutex);
+        learner->dropped++;
+        pthread_mutex_unlock(&learner->mutex);
+        return -1;
+    }
+    update->next = NULL;
+    update->received_at = monotonic_seconds();
+    update->example = example;
+    
+    pthread_mutex_lock(&learner->mutex);
+    if (learner->tail) {
+        learner->tail->next = update;
+    } else {
+        learner->head = update;
+    }
+    learner->tail = update;
+    learner->queued++;
+    pthread_cond_signal(&learner->cond);
+    pthread_mutex_unlock(&learner->mutex);
+    return 0;
+}
+
+int learner_submit(Learner* learner, TokenizationResult* tokens, const char* domain) {
+    if (reject_if_full(learner)) {
+        return -1;
+    }
+    // copierea se face in afara lock-ului
+    return enqueue_example(learner, create_training_example(tokens, domain));
+}
+
+int learner_submit_example(Learner* learner, TrainingExample* example) {
+    if (reject_if_full(learner)) {
+        free(example);
+        return -1;
+    }
+    return enqueue_example(learner, example);
+}
+
+static void apply_batch(BayesClassifier* classifier, PendingUpdate* batch) {
+    for (PendingUpdate* update = batch; update; update = update->next) {
+        train_bayes_classifier_example(classifier, update->example);
+    }
+}
+
+static void free_batch(PendingUpdate* batch) {
+    while (batch) {
+        PendingUpdate* next = batch->next;
+        free(batch->example);
+        free(batch);
+        batch = next;
+    }
+}
+
+// Asteapta cititorii care au luat copia inainte de publicarea celeilalte
+static void wait_for_readers(ModelCopy* copy) {
+    struct timespec pause = { 0, DRAIN_SLEEP_NS };
+    for (int spins = 0; atomic_load(&copy->readers) > 0; spins++) {
+        if (spins < DRAIN_SPINS) {
+            sched_yield();
+        } else {
+            nanosleep(&pause, NULL);
+        }
+    }
+}
+
+static void record_applied(Learner* learner, int count) {
+    long second = (long)monotonic_seconds();
+    int slot = second % RATE_WINDOW;
+    if (learner->rate_seconds[slot] != second) {
+        learner->rate_seconds[slot] = second;
+        learner->rate_counts[slot] = 0;
+    }
+    learner->rate_counts[slot] += count;
+    learner->applied += count;
+    learner->batches++;
+}
+
+static void* learner_thread(void* arg) {
+    Learner* learner = (Learner*)arg;
+    
+    while (1) {
+        pthread_mutex_lock(&learner->mutex);
+        while (!learner->head && !learner->stop) {
+            pthread_cond_wait(&learner->cond, &learner->mutex);
+        }
+        if (learner->stop) {
+            pthread_mutex_unlock(&learner->mutex);
+            break;
+        }
+    
+        // cel mult MAX_BATCH documente, ca o generatie sa nu astepte prea mult
+        PendingUpdate* batch = learner->head;
+        PendingUpdate* last = batch;
+        int count = 1;
+        while (last->next && count < MAX_BATCH) {
+            last = last->next;
+            count++;
+        }
+        learner->head = last->next;
+        if (!learner->head) {
+            learner->tail = NULL;
+        }
+        last->next = NULL;
+        learner->queued -= count;
+        learner->in_flight = count;
+        learner->in_flight_since = batch->received_at;
+        pthread_mutex_unlock(&learner->mutex);
+    
+        // copia nepublicata nu are cititori: lotul se aplica fara lock-uri
+        int published = atomic_load(&learner->current);
+        int standby = 1 - published;
+        apply_batch(learner->copies[standby].classifier, batch);
+    
+        // intai copia, apoi generatia: un rezultat calculat pe copia veche
+        // nu poate fi pastrat in cache sub generatia noua
+        atomic_store(&learner->current, standby);
+        atomic_fetch_add(&learner->generation, 1);
+        atomic_fetch_add(&learner->documents, count);
+    
+        wait_for_readers(&learner->copies[published]);
+        apply_batch(learner->copies[published].classifier, batch);
+        free_batch(batch);
+    
+        pthread_mutex_lock(&learner->mutex);
+        learner->in_flight = 0;
+        record_applied(learner, count);
+        pthread_mutex_unlock(&learner->mutex);
+    }
+    return NULL;
+}
+
+Learner* learner_create(BayesClassifier* first, BayesClassifier* second, int max_pending) {
+    Learner* learner = (Learner*)aligned_alloc(CACHE_LINE, sizeof(Learner));
+    if (!learner) {
+        return NULL;
+    }
+    memset(learner, 0, sizeof(Learner));
+    
+    learner->copies[0].classifier = first;
+    learner->copies[1].classifier = second;
+    atomic_init(&learner->copies[0].readers, 0);
+    atomic_init(&learner->copies[1].readers, 0);
+    atomic_init(&learner->current, 0);
+    atomic_init(&learner->generation, 0);
+    atomic_init(&learner->documents, 0);
+    learner->max_pending = max_pending;
+    pthread_mutex_init(&learner->mutex, NULL);
+    pthread_cond_init(&learner->cond, NULL);
+    
+    if (pthread_create(&learner->thread, NULL, learner_thread, learner) != 0) {
+        pthread_mutex_destroy(&learner->mutex);
+        pthread_cond_destroy(&learner->cond);
+        free(learner);
+        return NULL;
+    }
+    return learner;
+}
+
+void learner_destroy(Learner* learner) {
+    if (!learner) return;
+    
+    pthread_mutex_lock(&learner->mutex);
+    learner->stop = 1;
+    pthread_cond_signal(&learner->cond);
+    pthread_mutex_unlock(&learner->mutex);
+    pthread_join(learner->thread, NULL);
+    
+    free_batch(learner->head);
+    free_bayes_classifier(learner->copies[0].classifier);
+    free_bayes_classifier(learner->copies[1].classifier);
+    pthread_mutex_destroy(&learner->mutex);
+    pthread_cond_destroy(&learner->cond);
+    free(learner);
+}
+
+void learner_stats(Learner* learner, LearnerStats* stats) {
+    double now = monotonic_seconds();
+    long second = (long)now;
+    
+    pthread_mutex_lock(&learner->mutex);
+    stats->pending = learner->queued + learner->in_flight;
+    stats->applied = learner->applied;
+    stats->dropped = learner->dropped;
+    stats->batches = learner->batches;
+    
+    double oldest = now;
+    if (learner->in_flight) {
+        oldest = learner->in_flight_since;
+    } else if (learner->head) {
+        oldest = learner->head->received_at;
+    }
+    stats->lag_seconds = now - oldest;
+    
+    uint64_t recent = 0;
+    for (int i = 0; i < RATE_WINDOW; i++) {
+        if (second - learner->rate_seconds[i] < RATE_WINDOW) {
+            recent += learner->rate_counts[i];
+        }
+    }
+    pthread_mutex_unlock(&learner->mutex);
+    stats->updates_per_second = (double)recent / RATE_WINDOW;
+}
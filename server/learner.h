@@ -0,0 +1,39 @@
+#ifndef LEARNER_H
+#define LEARNER_H
+
+#include <stdint.h>
+#include "../common/nlp.h"
+#include "../common/protocol.h"
+
+// Antrenare online in afara drumului cererilor. Clasificatorul exista in
+// doua copii: cititorii folosesc copia publicata, fara lock-uri, iar un
+// thread de fundal aplica documentele primite, in loturi, pe cealalta.
+// Dupa un lot copiile se inverseaza atomic (o noua generatie), cititorii
+// ramasi pe copia veche se termina, apoi lotul se aplica si pe ea.
+typedef struct Learner Learner;
+
+// Preia cele doua copii, care trebuie sa fie identice. max_pending limiteaza
+// documentele care asteapta; peste ea learner_submit le renunta.
+// NULL la eroare (alocare sau thread).
+Learner* learner_create(BayesClassifier* first, BayesClassifier* second, int max_pending);
+// Opreste thread-ul (documentele ramase se pierd) si elibereaza modelul
+void learner_destroy(Learner* learner);
+
+// Copia publicata, nemodificata pana la learner_release(copy)
+BayesClassifier* learner_acquire(Learner* learner, int* copy);
+void learner_release(Learner* learner, int copy);
+
+// Creste la fiecare lot publicat; dupa ea se salveaza modelul
+uint64_t learner_generation(Learner* learner);
+// Documentele din copia publicata; creste cu fiecare lot, dupa generatie
+uint64_t learner_documents(Learner* learner);
+
+// Copiaza tokenii; nu asteapta niciodata antrenarea. 0 sau -1 daca
+// documentul a fost renuntat (coada plina sau eroare de alocare).
+int learner_submit(Learner* learner, TokenizationResult* tokens, const char* domain);
+// Ca learner_submit, dar preia example (antrenat pe example->domain)
+int learner_submit_example(Learner* learner, TrainingExample* example);
+
+void learner_stats(Learner* learner, LearnerStats* stats);
+
+#endif
@@ -0,0 +1,241 @@
+#include "request_queue.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#else
+#include <pthread.h>
+#endif
+
+// incercari de a lua/pune un element inainte de a adormi thread-ul
+#define SPIN_ATTEMPTS 64
+
+// bench/stress_queue compileaza coada cu o pauza intre anuntarea in
+// park() si reverificare, ca sa simuleze preemptarea in acel punct
+#ifdef QUEUE_PARK_DELAY_US
+#define PARK_DELAY() usleep(QUEUE_PARK_DELAY_US)
+#else
+#define PARK_DELAY()
+#endif
+
+#ifdef __linux__
+
+static void event_wait(atomic_uint* events, unsigned int key) {
+    syscall(SYS_futex, events, FUTEX_WAIT_PRIVATE, key, NULL, NULL, 0);
+}
+
+static void event_wake(atomic_uint* events) {
+    syscall(SYS_futex, events, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+#else
+
+// fara futex: un mutex/condvar folosit doar pentru a dormi, niciodata pe calea rapida
+static pthread_mutex_t park_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t park_cond = PTHREAD_COND_INITIALIZER;
+
+static void event_wait(atomic_uint* events, unsigned int key) {
+    pthread_mutex_lock(&park_mutex);
+    while (atomic_load(events) == key) {
+        pthread_cond_wait(&park_cond, &park_mutex);
+    }
+    pthread_mutex_unlock(&park_mutex);
+}
+
+static void event_wake(atomic_uint* events) {
+    pthread_mutex_lock(&park_mutex);
+    pthread_cond_broadcast(&park_cond);
+    pthread_mutex_unlock(&park_mutex);
+}
+
+#endif
+
+static void init_event(QueueEvent* event) {
+    atomic_init(&event->events, 0);
+    atomic_init(&event->state, 0);
+}
+
+// Trezeste un thread care asteapta, daca exista si daca nu e deja unul trezit.
+// Fence-ul pereche e in park(): fie cel care adoarme vede starea noua a
+// cozii, fie noi vedem ca asteapta. Bitul de trezire se pune in acelasi
+// cuvant cu numarul celor care asteapta, deci doar cat timp exista unul
+// anuntat, care il va sterge.
+static void notify(QueueEvent* event) {
+    atomic_thread_fence(memory_order_seq_cst);
+    unsigned int state = atomic_load_explicit(&event->state, memory_order_relaxed);
+    do {
+        if (QUEUE_EVENT_WAITING(state) == 0 || (state & QUEUE_EVENT_WAKE_PENDING)) {
+            return;
+        }
+    } while (!atomic_compare_exchange_weak(&event->state, &state, state | QUEUE_EVENT_WAKE_PENDING));
+    
+    atomic_fetch_add(&event->events, 1);
+    event_wake(&event->events);
+}
+
+// Iesirea din park(), trezit sau nu: stergem si bitul de trezire. Poate fi
+// trezirea noastra (ready() a reusit intre timp); apelantul reincearca sau,
+// daca a reusit, transmite trezirea mai departe cand mai e de lucru.
+static void leave(QueueEvent* event) {
+    unsigned int state = atomic_load(&event->state);
+    while (!atomic_compare_exchange_weak(&event->state, &state,
+                                         (state - QUEUE_EVENT_WAITER) & ~QUEUE_EVENT_WAKE_PENDING)) {
+    }
+}
+
+// Adoarme pana la urmatorul notify(), daca ready() tot esueaza dupa ce
+// ne-am anuntat. ready e apelat cu arg si intoarce 1 la succes.
+static int park(QueueEvent* event, int (*ready)(RequestQueue*, void*), RequestQueue* queue, void* arg) {
+    unsigned int key = atomic_load(&event->events);
+    atomic_fetch_add(&event->state, QUEUE_EVENT_WAITER);
+    atomic_thread_fence(memory_order_seq_cst);
+    PARK_DELAY();
+    
+    if (ready(queue, arg)) {
+        leave(event);
+        return 1;
+    }
+    
+    // daca un notify a avansat events dupa ce am citit key, nu adormim
+    event_wait(&event->events, key);
+    leave(event);
+    return 0;
+}
+
+int init_queue(RequestQueue* queue, size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+    
+    queue->cells = (QueueCell*)malloc(size * sizeof(QueueCell));
+    if (!queue->cells) {
+        return -1;
+    }
+    
+    for (size_t i = 0; i < size; i++) {
+        atomic_init(&queue->cells[i].sequence, i);
+    }
+    queue->mask = size - 1;
+    
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    queue->spin_limit = cpus > 1 ? SPIN_ATTEMPTS : 0;
+    
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+    init_event(&queue->not_empty);
+    init_event(&queue->not_full);
+    return 0;
+}
+
+void destroy_queue(RequestQueue* queue) {
+    free(queue->cells);
+    queue->cells = NULL;
+}
+
+int try_enqueue(RequestQueue* queue, const ProcessingRequest* request) {
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    
+    for (;;) {
+        QueueCell* cell = &queue->cells[pos & queue->mask];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        
+        if (diff == 0) {
+            // celula libera: o rezervam mutand enqueue_pos
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                cell->request = *request;
+                atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;  // plina
+        } else {
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+int try_dequeue(RequestQueue* queue, ProcessingRequest* request) {
+    size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    
+    for (;;) {
+        QueueCell* cell = &queue->cells[pos & queue->mask];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+        
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                *request = cell->request;
+                // celula redevine libera pentru runda urmatoare a inelului
+                atomic_store_explicit(&cell->sequence, pos + queue->mask + 1, memory_order_release);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;  // goala
+        } else {
+            pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+static int enqueue_ready(RequestQueue* queue, void* request) {
+    return try_enqueue(queue, (const ProcessingRequest*)request);
+}
+
+static int dequeue_ready(RequestQueue* queue, void* request) {
+    return try_dequeue(queue, (ProcessingRequest*)request);
+}
+
+// Adauga cererea; daca inelul e plin, producatorul asteapta un loc liber
+int enqueue(RequestQueue* queue, ProcessingRequest request) {
+    for (int spin = 0; ; spin++) {
+        if (try_enqueue(queue, &request) ||
+            (spin >= queue->spin_limit && park(&queue->not_full, enqueue_ready, queue, &request))) {
+            notify(&queue->not_empty);
+            // mai e loc: trezirea trece la urmatorul producator care asteapta
+            atomic_thread_fence(memory_order_seq_cst);
+            if (queue_size(queue) < queue_capacity(queue)) {
+                notify(&queue->not_full);
+            }
+            return 0;
+        }
+    }
+}
+
+// Extrage o cerere; daca inelul e gol, consumatorul asteapta
+ProcessingRequest dequeue(RequestQueue* queue) {
+    ProcessingRequest request;
+    
+    for (int spin = 0; ; spin++) {
+        if (try_dequeue(queue, &request) ||
+            (spin >= queue->spin_limit && park(&queue->not_empty, dequeue_ready, queue, &request))) {
+            notify(&queue->not_full);
+            // mai sunt cereri: trezirea trece la urmatorul consumator care asteapta
+            atomic_thread_fence(memory_order_seq_cst);
+            if (queue_size(queue) > 0) {
+                notify(&queue->not_empty);
+            }
+            return request;
+        }
+    }
+}
+
+int queue_size(RequestQueue* queue) {
+    size_t tail = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    intptr_t size = (intptr_t)(head - tail);
+    
+    if (size < 0) return 0;
+    if (size > (intptr_t)queue->mask + 1) return queue->mask + 1;
+    return (int)size;
+}
+
+int queue_capacity(RequestQueue* queue) {
+    return (int)(queue->mask + 1);
+}
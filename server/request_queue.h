@@ -0,0 +1,75 @@
+#ifndef REQUEST_QUEUE_H
+#define REQUEST_QUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "../common/protocol.h"
+#include "buffer_pool.h"
+
+// Structura pentru o cerere de procesare
+typedef struct {
+    int client_fd;
+    Buffer* text;         // textul unui lot contine '\0' intre elemente
+    RequestType type; // Definit în protocol.h
+    int version;          // versiunea cadrului, folosita si pentru raspuns
+    int flags;
+    unsigned int request_id;
+    struct TextStream* stream;   // bucata dintr-un flux (text e atunci NULL)
+} ProcessingRequest;
+
+// Celula din inel: numarul de secventa spune cine o poate folosi
+// (producatorul pentru pozitia pos cand sequence == pos, consumatorul
+// cand sequence == pos + 1)
+typedef struct {
+    atomic_size_t sequence;
+    ProcessingRequest request;
+} QueueCell;
+
+#define QUEUE_CACHE_LINE 64
+
+// Contor de evenimente pe care adorm thread-urile (futex pe Linux).
+// state tine numarul thread-urilor anuntate (de la bitul 1 in sus) si un
+// bit de trezire in curs, care limiteaza trezirile la una: thread-ul trezit
+// o transmite mai departe daca mai are de lucru pentru altii.
+typedef struct {
+    _Alignas(QUEUE_CACHE_LINE) atomic_uint events;
+    atomic_uint state;
+} QueueEvent;
+
+#define QUEUE_EVENT_WAKE_PENDING 1u
+#define QUEUE_EVENT_WAITER 2u
+#define QUEUE_EVENT_WAITING(state) ((state) / QUEUE_EVENT_WAITER)
+
+// Coada FIFO limitata, fara lock-uri, multi-producator/multi-consumator
+// (inel cu numere de secventa, in stilul Vyukov). Thread-urile care gasesc
+// coada goala (sau plina) adorm pe un QueueEvent in loc sa consume CPU.
+typedef struct {
+    QueueCell* cells;
+    size_t mask;                 // capacitate - 1 (capacitatea e putere a lui 2)
+    int spin_limit;              // incercari inainte de a adormi (0 pe un singur nucleu)
+    
+    _Alignas(QUEUE_CACHE_LINE) atomic_size_t enqueue_pos;
+    _Alignas(QUEUE_CACHE_LINE) atomic_size_t dequeue_pos;
+    
+    QueueEvent not_empty;
+    QueueEvent not_full;
+} RequestQueue;
+
+// capacity se rotunjeste la urmatoarea putere a lui 2
+int init_queue(RequestQueue* queue, size_t capacity);
+void destroy_queue(RequestQueue* queue);
+
+// Blocheaza cat timp coada e plina
+int enqueue(RequestQueue* queue, ProcessingRequest request);
+// Blocheaza cat timp coada e goala
+ProcessingRequest dequeue(RequestQueue* queue);
+
+// Variante neblocante: 1 la succes, 0 daca coada e plina / goala
+int try_enqueue(RequestQueue* queue, const ProcessingRequest* request);
+int try_dequeue(RequestQueue* queue, ProcessingRequest* request);
+
+// Aproximare fara lock, pentru monitorizare
+int queue_size(RequestQueue* queue);
+int queue_capacity(RequestQueue* queue);
+
+#endif
@@ -0,0 +1,318 @@
+#include "result_cache.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHE_SHARDS 16
+#define CACHE_LINE 64
+
+// marimea estimata a unei intrari, pentru dimensionarea tabelei unui shard
+#define AVERAGE_ENTRY_SIZE 256
+#define MIN_BUCKETS 64
+
+typedef struct CacheEntry {
+    CacheKey key;
+    uint64_t generation;
+    int word_count;
+    size_t size;                // bytes socotiti din buget
+    struct CacheEntry* chain;   // urmatoarea intrare din acelasi bucket
+    struct CacheEntry* prev;    // lista LRU, de la cea mai recent folosita
+    struct CacheEntry* next;
+    char* topic;                // in data, NULL daca lipseste
+    char* summary;
+    TrainingExample* example;   // tokenii documentului, NULL daca nu au fost dati
+    char data[];                // textul documentului (key.text), topic, summary
+} CacheEntry;
+
+typedef struct {
+    _Alignas(CACHE_LINE) pthread_mutex_t lock;
+    CacheEntry** buckets;
+    size_t bucket_mask;
+    CacheEntry* head;
+    CacheEntry* tail;
+    size_t bytes;
+    size_t budget;
+    uint64_t entries;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t invalidations;
+    uint64_t evictions;
+} CacheShard;
+
+struct ResultCache {
+    CacheShard shards[CACHE_SHARDS];
+};
+
+static uint64_t rotate_left(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// amestecul final din MurmurHash3
+static uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Doua benzi de 64 de biti, cate 8 bytes de text pe pas
+void cache_key(RequestType type, const char* text, size_t length, CacheKey* key) {
+    uint64_t a = 0x9e3779b97f4a7c15ULL ^ length;
+    uint64_t b = 0xc2b2ae3d27d4eb4fULL ^ (uint64_t)type;
+    
+    size_t i = 0;
+    while (i < length) {
+        uint64_t word = 0;
+        size_t chunk = length - i < 8 ? length - i : 8;
+        memcpy(&word, text + i, chunk);
+        i += chunk;
+    
+        a = rotate_left((a ^ word) * 0x87c37b91114253d5ULL, 31);
+        b = rotate_left((b + word) * 0x4cf5ad432745937fULL, 27) ^ a;
+    }
+    
+    key->hash[0] = mix64(a + b);
+    key->hash[1] = mix64(b ^ rotate_left(a, 17));
+    key->length = length;
+    key->type = type;
+    key->text = text;
+}
+
+ResultCache* result_cache_create(size_t byte_budget) {
+    if (byte_budget == 0) {
+        return NULL;
+    }
+    
+    ResultCache* cache = (ResultCache*)aligned_alloc(CACHE_LINE, sizeof(ResultCache));
+    if (!cache) {
+        return NULL;
+    }
+    memset(cache, 0, sizeof(ResultCache));
+    
+    size_t shard_budget = byte_budget / CACHE_SHARDS;
+    size_t bucket_count = MIN_BUCKETS;
+    while (bucket_count < shard_budget / AVERAGE_ENTRY_SIZE) {
+        bucket_count *= 2;
+    }
+    
+    for (int i = 0; i < CACHE_SHARDS; i++) {
+        CacheShard* shard = &cache->shards[i];
+        shard->buckets = (CacheEntry**)calloc(bucket_count, sizeof(CacheEntry*));
+        if (!shard->buckets) {
+            result_cache_destroy(cache);
+            return NULL;
+        }
+        pthread_mutex_init(&shard->lock, NULL);
+        shard->bucket_mask = bucket_count - 1;
+        shard->budget = shard_budget;
+    }
+    
+    return cache;
+}
+
+void result_cache_destroy(ResultCache* cache) {
+    if (!cache) return;
+    
+    for (int i = 0; i < CACHE_SHARDS; i++) {
+        CacheShard* shard = &cache->shards[i];
+        if (!shard->buckets) {
+            continue;
+        }
+    
+        CacheEntry* entry = shard->head;
+        while (entry) {
+            CacheEntry* next = entry->next;
+            free(entry->example);
+            free(entry);
+            entry = next;
+        }
+        free(shard->buckets);
+        pthread_mutex_destroy(&shard->lock);
+    }
+    free(cache);
+}
+
+static CacheShard* shard_for(ResultCache* cache, const CacheKey* key) {
+    return &cache->shards[key->hash[1] % CACHE_SHARDS];
+}
+
+static int same_key(const CacheKey* a, const CacheKey* b) {
+    return a->hash[0] == b->hash[0] && a->hash[1] == b->hash[1] &&
+           a->length == b->length && a->type == b->type &&
+           memcmp(a->text, b->text, a->length) == 0;
+}
+
+// legatura din bucket care arata spre intrarea cu cheia data (sau spre NULL)
+static CacheEntry** find_slot(CacheShard* shard, const CacheKey* key) {
+    CacheEntry** slot = &shard->buckets[key->hash[0] & shard->bucket_mask];
+    while (*slot && !same_key(&(*slot)->key, key)) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+static void lru_unlink(CacheShard* shard, CacheEntry* entry) {
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        shard->head = entry->next;
+    }
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        shard->tail = entry->prev;
+    }
+}
+
+static void lru_push_front(CacheShard* shard, CacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = shard->head;
+    if (shard->head) {
+        shard->head->prev = entry;
+    } else {
+        shard->tail = entry;
+    }
+    shard->head = entry;
+}
+
+// scoate intrarea spre care arata slot din bucket, din LRU si din buget
+static void remove_entry(CacheShard* shard, CacheEntry** slot) {
+    CacheEntry* entry = *slot;
+    *slot = entry->chain;
+    lru_unlink(shard, entry);
+    shard->bytes -= entry->size;
+    shard->entries--;
+    free(entry->example);
+    free(entry);
+}
+
+static char* copy_string(const char* text) {
+    return text ? strdup(text) : NULL;
+}
+
+int result_cache_lookup(ResultCache* cache, const CacheKey* key, uint64_t generation, Response* response,
+                        TrainingExample** example) {
+    CacheShard* shard = shard_for(cache, key);
+    pthread_mutex_lock(&shard->lock);
+    
+    CacheEntry** slot = find_slot(shard, key);
+    CacheEntry* entry = *slot;
+    if (entry && entry->generation != generation) {
+        // modelul s-a schimbat de cand a fost calculat rezultatul
+        remove_entry(shard, slot);
+        shard->invalidations++;
+        entry = NULL;
+    }
+    
+    char* topic = NULL;
+    char* summary = NULL;
+    TrainingExample* tokens = NULL;
+    if (entry) {
+        topic = copy_string(entry->topic);
+        summary = copy_string(entry->summary);
+        if (example && entry->example) {
+            tokens = copy_training_example(entry->example);
+        }
+        if ((entry->topic && !topic) || (entry->summary && !summary) ||
+            (example && entry->example && !tokens)) {
+            free(topic);
+            free(summary);
+            free(tokens);
+            entry = NULL;
+        }
+    }
+    
+    if (!entry) {
+        shard->misses++;
+        pthread_mutex_unlock(&shard->lock);
+        return 0;
+    }
+    
+    lru_unlink(shard, entry);
+    lru_push_front(shard, entry);
+    shard->hits++;
+    
+    response->status = STATUS_OK;
+    response->word_count = entry->word_count;
+    response->topic = topic;
+    response->summary = summary;
+    if (example) {
+        *example = tokens;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return 1;
+}
+
+void result_cache_store(ResultCache* cache, const CacheKey* key, uint64_t generation, const Response* response,
+                        TrainingExample* example) {
+    if (response->status != STATUS_OK) {
+        free(example);
+        return;
+    }
+    
+    CacheShard* shard = shard_for(cache, key);
+    size_t topic_len = response->topic ? strlen(response->topic) + 1 : 0;
+    size_t summary_len = response->summary ? strlen(response->summary) + 1 : 0;
+    size_t entry_size = sizeof(CacheEntry) + key->length + topic_len + summary_len;
+    size_t size = entry_size + (example ? example->size : 0);
+    if (size > shard->budget) {
+        free(example);
+        return;
+    }
+    
+    // intrarea se construieste in afara lock-ului
+    CacheEntry* entry = (CacheEntry*)malloc(entry_size);
+    if (!entry) {
+        free(example);
+        return;
+    }
+    entry->key = *key;
+    entry->key.text = memcpy(entry->data, key->text, key->length);
+    entry->generation = generation;
+    entry->word_count = response->word_count;
+    entry->size = size;
+    char* strings = entry->data + key->length;
+    entry->topic = topic_len ? memcpy(strings, response->topic, topic_len) : NULL;
+    entry->summary = summary_len ? memcpy(strings + topic_len, response->summary, summary_len) : NULL;
+    entry->example = example;
+    
+    pthread_mutex_lock(&shard->lock);
+    
+    CacheEntry** slot = find_slot(shard, key);
+    if (*slot) {
+        remove_entry(shard, slot);
+    }
+    
+    while (shard->bytes + size > shard->budget) {
+        remove_entry(shard, find_slot(shard, &shard->tail->key));
+        shard->evictions++;
+    }
+    
+    CacheEntry** bucket = &shard->buckets[key->hash[0] & shard->bucket_mask];
+    entry->chain = *bucket;
+    *bucket = entry;
+    lru_push_front(shard, entry);
+    shard->bytes += size;
+    shard->entries++;
+    
+    pthread_mutex_unlock(&shard->lock);
+}
+
+void result_cache_stats(ResultCache* cache, CacheStats* stats) {
+    memset(stats, 0, sizeof(CacheStats));
+    
+    for (int i = 0; i < CACHE_SHARDS; i++) {
+        CacheShard* shard = &cache->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        stats->hits += shard->hits;
+        stats->misses += shard->misses;
+        stats->invalidations += shard->invalidations;
+        stats->evictions += shard->evictions;
+        stats->entries += shard->entries;
+        stats->bytes += shard->bytes;
+        stats->capacity += shard->budget;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
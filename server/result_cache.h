@@ -0,0 +1,45 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../common/nlp.h"
+#include "../common/protocol.h"
+
+// Cheia unui rezultat: hash de 128 de biti peste text, plus tipul cererii
+// si lungimea textului. Hash-ul doar alege intrarea: o potrivire se
+// confirma comparand textul, pe care fiecare intrare il pastreaza, ca doua
+// documente cu acelasi hash (si coliziunile construite intentionat) sa nu
+// primeasca acelasi rezultat.
+typedef struct {
+    uint64_t hash[2];
+    size_t length;
+    RequestType type;
+    const char* text;       // nu e copiat; trebuie sa traiasca cat cheia
+} CacheKey;
+
+// Cache LRU pentru raspunsurile la documente repetate, impartit in
+// shard-uri cu lock separat (shard-ul se alege din hash). Bugetul de
+// memorie include intrarile si textele si tokenii pastrati in ele.
+typedef struct ResultCache ResultCache;
+
+// NULL la eroare de alocare sau daca byte_budget e 0 (cache dezactivat)
+ResultCache* result_cache_create(size_t byte_budget);
+void result_cache_destroy(ResultCache* cache);
+
+void cache_key(RequestType type, const char* text, size_t length, CacheKey* key);
+
+// Fiecare intrare poarta generatia modelului pentru care a fost calculata;
+// o intrare cu alta generatie decat cea ceruta e invalida si se elimina.
+// Intoarce 1 si completeaza status, word_count, topic si summary (copii
+// noi, eliberate de apelant) sau 0 daca rezultatul lipseste. Daca example
+// nu e NULL, primeste si o copie a tokenilor pastrati (sau NULL).
+int result_cache_lookup(ResultCache* cache, const CacheKey* key, uint64_t generation, Response* response,
+                        TrainingExample** example);
+// Doar raspunsurile STATUS_OK; o intrare mai veche cu aceeasi cheie e
+// inlocuita. Preia example (tokenii documentului, poate fi NULL).
+void result_cache_store(ResultCache* cache, const CacheKey* key, uint64_t generation, const Response* response,
+                        TrainingExample* example);
+void result_cache_stats(ResultCache* cache, CacheStats* stats);
+
+#endif
@@ -5,196 +5,697 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <pthread.h>
-#include <poll.h>
+#include <stdatomic.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <time.h>
 #include "../common/nlp.h"
+#include "../common/model_snapshot.h"
 #include "../common/protocol.h"
+#include "request_queue.h"
+#include "connection.h"
+#include "result_cache.h"
+#include "learner.h"
 #include <arpa/inet.h> 
 
 #define TCP_PORT 12345
 #define UNIX_SOCKET_PATH "/tmp/nlp_admin_socket"
 #define MAX_CLIENTS 10
 #define BUFFER_SIZE 8192
-#define MAX_QUEUE_SIZE 100
+#define MAX_QUEUE_SIZE 128
+#define MAX_EVENTS 256
+#define READ_BUFFER_SIZE 65536
+
+// Bucati dintr-un flux aflate la procesare pe o conexiune; peste aceasta
+// limita reactorul nu mai citeste de pe ea pana nu se termina una
+#define MAX_QUEUED_CHUNKS 4
+
+// La fel pentru cererile aflate la procesare si raspunsurile netrimise: un
+// client care trimite cereri in pipeline dar nu citeste raspunsurile nu
+// poate umple memoria serverului
+#define MAX_PENDING_REQUESTS 256
+#define MAX_OUTPUT_BYTES (4 * 1024 * 1024)
+
+// Limitele implicite ale corpusului folosit pentru IDF
+#define DEFAULT_CORPUS_MAX_DOCUMENTS 10000
+#define DEFAULT_CORPUS_MAX_BYTES (64 * 1024 * 1024)
+#define DEFAULT_CORPUS_MAX_AGE 0
+
+// Memoria implicita a cache-ului de rezultate
+#define DEFAULT_CACHE_BYTES (32 * 1024 * 1024)
+
+#define REQUEST_TYPE_BIT(type) (1 << (type))
+
+#define MAX_KEYWORD_FILES 16
+
+// Cat de des se salveaza modelul (cu --model), daca s-a schimbat
+#define DEFAULT_MODEL_SAVE_INTERVAL 300
+
+// Cereri ADMIN_SAVE_MODEL care pot astepta salvarea in acelasi timp
+#define MAX_PENDING_SAVES 8
+
+// Rezultatele din cache pot ignora cel mult atatea modificari ale modelului
+#define CACHE_EPOCH_CHANGES 64
+
+// Documente clasificate care pot astepta antrenarea in fundal
+#define DEFAULT_LEARNER_QUEUE 4096
 
-// Structura pentru o cerere de procesare
-typedef struct {
-    int client_fd;
-    char* text;
-    RequestType type; // Definit în protocol.h
-} ProcessingRequest;
 
-// Coada FIFO pentru cererile de procesare
+// Configuratia serverului (implicit + linia de comanda)
 typedef struct {
-    ProcessingRequest queue[MAX_QUEUE_SIZE];
-    int front;
-    int rear;
-    int count;
-    pthread_mutex_t mutex;
-    pthread_cond_t not_empty;
-    pthread_cond_t not_full;
-} RequestQueue;
+    int corpus_max_documents;   // 0 = nelimitat
+    size_t corpus_max_bytes;    // 0 = nelimitat
+    int corpus_max_age;         // secunde, 0 = fara fereastra de timp
+    int corpus_feed;            // REQUEST_TYPE_BIT pentru cererile adaugate in corpus
+    int workers;                // thread-uri de procesare, 0 = cate un nucleu
+    size_t cache_bytes;         // bugetul cache-ului de rezultate, 0 = dezactivat
+    int cache_hits_learn;       // un document gasit in cache antreneaza si alimenteaza corpusul
+                                // (intrarile pastreaza atunci si tokenii)
+    int strip_diacritics;       // tokenii pierd diacriticele
+    const char* keyword_files[MAX_KEYWORD_FILES];   // cuvinte cheie in plus pentru topic
+    int keyword_file_count;
+    const char* model_path;     // snapshot-ul modelului Bayes, NULL = doar in memorie
+    int model_save_interval;    // secunde, 0 = doar la cererea administratorului
+    int learner_queue;          // documente care asteapta antrenarea, apoi se renunta la ele
+} ServerConfig;
 
 
 // Variabile globale
+ServerConfig config = {
+    DEFAULT_CORPUS_MAX_DOCUMENTS,
+    DEFAULT_CORPUS_MAX_BYTES,
+    DEFAULT_CORPUS_MAX_AGE,
+    REQUEST_TYPE_BIT(REQUEST_DETERMINE_TOPIC) | REQUEST_TYPE_BIT(REQUEST_GENERATE_SUMMARY),
+    0,
+    DEFAULT_CACHE_BYTES,
+    0,
+    0,
+    { NULL },
+    0,
+    NULL,
+    DEFAULT_MODEL_SAVE_INTERVAL,
+    DEFAULT_LEARNER_QUEUE
+};
 RequestQueue request_queue;
 ClientInfo clients[MAX_CLIENTS];
 pthread_mutex_t clients_mutex = PTHREAD_MUTEX_INITIALIZER;
 int client_count = 0;
 
 
-void init_queue() {
-    request_queue.front = 0;
-    request_queue.rear = -1;
-    request_queue.count = 0;
-    pthread_mutex_init(&request_queue.mutex, NULL);
-    pthread_cond_init(&request_queue.not_empty, NULL);
-    pthread_cond_init(&request_queue.not_full, NULL);
+// Modelul comun tuturor thread-urilor de procesare. Clasificatorul e
+// antrenat in fundal de learner (vezi learner.h), iar clasificarea nu
+// asteapta niciodata antrenarea. Citirile corpusului (IDF) ruleaza in
+// paralel; actualizarea lui ia lock-ul de scriere. Fiecare modificare
+// creste generatia partii respective; rezultatele din cache se invalideaza
+// abia cand se schimba epoca (vezi model_epoch).
+typedef struct {
+    Learner* learner;
+    DocumentCollection* collection;
+    pthread_rwlock_t collection_lock;
+    _Atomic uint64_t collection_generation;
+} SharedModel;
+
+SharedModel model;
+ResultCache* result_cache = NULL;
+
+// Salvarea modelului in config.model_path, facuta de un thread separat:
+// periodic, daca generatia clasificatorului s-a schimbat, sau imediat
+// pentru cererile ADMIN_SAVE_MODEL (reactorul doar le pune in lista).
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int pending[MAX_PENDING_SAVES];     // socket-urile admin care asteapta raspunsul
+    int pending_count;
+    uint64_t saved_generation;
+    ModelStats stats;                   // ultima salvare reusita
+} ModelSaver;
+
+ModelSaver model_saver = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, { 0 }, 0, 0, { 0, 0, 0, 0.0 } };
+
+// Raspunsuri gata de trimis. Thread-urile de procesare nu scriu in socket-uri:
+// pun raspunsul codificat in lista si trezesc reactorul prin eventfd.
+typedef struct Completion {
+    int client_fd;
+    char* data;
+    size_t length;
+    int chunk_done;     // o bucata dintr-un flux a fost analizata (fara date)
+    struct Completion* next;
+} Completion;
+
+typedef struct {
+    Completion* head;
+    Completion* tail;
+    pthread_mutex_t mutex;
+    int event_fd;
+} CompletionList;
+
+CompletionList completions = { NULL, NULL, PTHREAD_MUTEX_INITIALIZER, -1 };
+
+// Document primit pe bucati (REQUEST_FLAG_STREAM). Reactorul adauga bucatile
+// in lista, in ordine, si pune in coada cate o intrare pentru fiecare;
+// worker-ul care ia o intrare analizeaza, sub lock, prima bucata ramasa.
+// Asa bucatile se analizeaza in ordine, indiferent ce worker le ia.
+// Raspunsul final poarta antetul primei bucati, nu al intrarii care a
+// analizat bucata de final.
+typedef struct TextStream {
+    atomic_int refs;            // reactorul + intrarile din coada
+    pthread_mutex_t lock;
+    RequestType type;
+    int version;
+    int flags;
+    unsigned int request_id;
+    StreamAnalysis* analysis;   // NULL dupa o eroare de alocare
+    Buffer* head;               // bucati neanalizate, legate prin next;
+    Buffer* tail;               // una de lungime 0 incheie documentul
+    time_t start_time;
+} TextStream;
+
+// Conexiunile active, indexate dupa fd (folosite doar de thread-ul reactor)
+Connection** connections = NULL;
+int connection_slots = 0;
+int epoll_fd = -1;
+
+static double monotonic_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
 }
 
-// Adaugare cerere in coada
-int enqueue(ProcessingRequest request) {
-    pthread_mutex_lock(&request_queue.mutex);
+// Modelul de pornire cand nu exista un snapshot
+static BayesClassifier* train_default_model() {
+    BayesClassifier* classifier = init_bayes_classifier();
+    if (!classifier) {
+        return NULL;
+    }
     
-    while (request_queue.count >= MAX_QUEUE_SIZE) {
-        pthread_cond_wait(&request_queue.not_full, &request_queue.mutex);
+    train_bayes_classifier(classifier,
+        "Meciul de fotbal s-a terminat cu scorul de 2-1. Jucătorii au fost foarte buni.",
+        "Sport");
+    train_bayes_classifier(classifier,
+        "Echipa națională a câștigat campionatul. Fotbaliștii au jucat excelent în finală.",
+        "Sport");
+    
+    train_bayes_classifier(classifier,
+        "Președintele a anunțat noi măsuri economice. Parlamentul va dezbate legea mâine.",
+        "Politică");
+    train_bayes_classifier(classifier,
+        "Guvernul a aprobat noul buget. Opoziția critică deciziile luate de partidul de guvernare.",
+        "Politică");
+    
+    train_bayes_classifier(classifier,
+        "Noul smartphone are funcții avansate de inteligență artificială și baterie performantă.",
+        "Tehnologie");
+    train_bayes_classifier(classifier,
+        "Inteligența artificială revoluționează industria. Sistemele de învățare automată procesează date masive.",
+        "Tehnologie");
+    train_bayes_classifier(classifier,
+        "Algoritmii de machine learning și rețelele neurale sunt la baza multor aplicații moderne.",
+        "Tehnologie");
+    train_bayes_classifier(classifier,
+        "Companiile tech investesc în dezvoltarea de soluții bazate pe AI și automatizare.",
+        "Tehnologie");
+    return classifier;
+}
+
+// Snapshot-ul din config.model_path, daca exista; altfel modelul implicit
+static BayesClassifier* load_initial_model() {
+    if (!config.model_path || access(config.model_path, F_OK) < 0) {
+        return train_default_model();
     }
     
-    request_queue.rear = (request_queue.rear + 1) % MAX_QUEUE_SIZE;
-    request_queue.queue[request_queue.rear] = request;
-    request_queue.count++;
+    return load_model_snapshot(config.model_path, config.strip_diacritics);
+}
+
+int init_shared_model() {
+    // learner-ul are nevoie de doua copii identice ale modelului
+    double start = monotonic_seconds();
+    BayesClassifier* first = load_initial_model();
+    double seconds = monotonic_seconds() - start;
+    BayesClassifier* second = first ? load_initial_model() : NULL;
+    if (!second) {
+        free_bayes_classifier(first);
+        return -1;
+    }
+    if (first->snapshot) {
+        printf("Model încărcat din %s: %d cuvinte, %d documente (%.1f ms)\n", config.model_path,
+               first->vocabulary.count, first->total_documents, seconds * 1000.0);
+    }
+    
+    model.learner = learner_create(first, second, config.learner_queue);
+    model.collection = create_document_collection();
+    if (!model.learner || !model.collection) {
+        return -1;
+    }
+    
+    set_collection_limits(model.collection, config.corpus_max_documents,
+                          config.corpus_max_bytes, config.corpus_max_age);
     
-    pthread_cond_signal(&request_queue.not_empty);
-    pthread_mutex_unlock(&request_queue.mutex);
+    pthread_rwlock_init(&model.collection_lock, NULL);
     return 0;
 }
 
-// Extragere cerere din coada
-ProcessingRequest dequeue() {
-    pthread_mutex_lock(&request_queue.mutex);
-    
-    while (request_queue.count <= 0) {
-        pthread_cond_wait(&request_queue.not_empty, &request_queue.mutex);
+static void push_completion(Completion* completion) {
+    pthread_mutex_lock(&completions.mutex);
+    int was_empty = completions.head == NULL;
+    if (completions.tail) {
+        completions.tail->next = completion;
+    } else {
+        completions.head = completion;
     }
+    completions.tail = completion;
+    pthread_mutex_unlock(&completions.mutex);
     
-    ProcessingRequest request = request_queue.queue[request_queue.front];
-    request_queue.front = (request_queue.front + 1) % MAX_QUEUE_SIZE;
-    request_queue.count--;
+    // reactorul goleste toata lista la o trezire
+    if (was_empty) {
+        uint64_t one = 1;
+        if (write(completions.event_fd, &one, sizeof(one)) < 0) {
+            perror("Eroare la notificarea reactorului");
+        }
+    }
+}
+
+// Apelat de thread-urile de procesare; preia buffer-ul codificat
+void post_completion(int client_fd, char* data, size_t length) {
+    Completion* completion = (Completion*)malloc(sizeof(Completion));
+    if (!completion) {
+        free(data);
+        return;
+    }
     
-    pthread_cond_signal(&request_queue.not_full);
-    pthread_mutex_unlock(&request_queue.mutex);
-    return request;
+    completion->client_fd = client_fd;
+    completion->data = data;
+    completion->length = length;
+    completion->chunk_done = 0;
+    completion->next = NULL;
+    push_completion(completion);
 }
 
-void* processing_thread(void* arg) {
-    // Init clasificatorul Bayes si colectia de documente
-    static BayesClassifier* classifier = NULL;
-    static DocumentCollection* collection = NULL;
+// O bucata de flux a fost analizata: reactorul poate citi urmatoarele
+static void post_chunk_done(int client_fd) {
+    Completion* completion = (Completion*)calloc(1, sizeof(Completion));
+    if (!completion) {
+        return;
+    }
     
-    if (!classifier) {
-        classifier = init_bayes_classifier();
-        
-        train_bayes_classifier(classifier, 
-            "Meciul de fotbal s-a terminat cu scorul de 2-1. Jucătorii au fost foarte buni.",
-            "Sport");
-        train_bayes_classifier(classifier,
-            "Echipa națională a câștigat campionatul. Fotbaliștii au jucat excelent în finală.",
-            "Sport");
-        
-        train_bayes_classifier(classifier,
-            "Președintele a anunțat noi măsuri economice. Parlamentul va dezbate legea mâine.",
-            "Politică");
-        train_bayes_classifier(classifier,
-            "Guvernul a aprobat noul buget. Opoziția critică deciziile luate de partidul de guvernare.",
-            "Politică");
-        
-        train_bayes_classifier(classifier,
-            "Noul smartphone are funcții avansate de inteligență artificială și baterie performantă.",
-            "Tehnologie");
-        train_bayes_classifier(classifier,
-            "Inteligența artificială revoluționează industria. Sistemele de învățare automată procesează date masive.",
-            "Tehnologie");
-        train_bayes_classifier(classifier,
-            "Algoritmii de machine learning și rețelele neurale sunt la baza multor aplicații moderne.",
-            "Tehnologie");
-        train_bayes_classifier(classifier,
-            "Companiile tech investesc în dezvoltarea de soluții bazate pe AI și automatizare.",
-            "Tehnologie");
-        
+    completion->client_fd = client_fd;
+    completion->chunk_done = 1;
+    push_completion(completion);
+}
+
+static int corpus_feeds(RequestType type) {
+    return type <= REQUEST_GENERATE_SUMMARY && (config.corpus_feed & REQUEST_TYPE_BIT(type));
+}
+
+// Actualizare corpus (index de frecventa pentru IDF); tokens e NULL daca
+// tipul cererii nu alimenteaza corpusul. Generatia corpusului numara
+// documentele adaugate si eliminate.
+static void update_corpus(RequestType type, TokenizationResult* tokens) {
+    if (tokens) {
+        pthread_rwlock_wrlock(&model.collection_lock);
+        add_document(model.collection, tokens);
+        atomic_fetch_add(&model.collection_generation, 1);
+        pthread_rwlock_unlock(&model.collection_lock);
+    } else if (type == REQUEST_GENERATE_SUMMARY && config.corpus_max_age > 0) {
+        // fereastra de timp avanseaza si fara documente noi
+        pthread_rwlock_wrlock(&model.collection_lock);
+        int documents = model.collection->document_count;
+        enforce_collection_limits(model.collection, time(NULL));
+        if (model.collection->document_count != documents) {
+            atomic_fetch_add(&model.collection_generation, documents - model.collection->document_count);
+        }
+        pthread_rwlock_unlock(&model.collection_lock);
+    }
+}
+
+// Epoca partii din model de care depinde raspunsul la o cerere de tipul
+// dat (numararea cuvintelor nu depinde de model): avanseaza o data la
+// CACHE_EPOCH_CHANGES documente aplicate clasificatorului, respectiv
+// modificari ale corpusului, nu la fiecare document
+static uint64_t model_epoch(RequestType type) {
+    switch (type) {
+        case REQUEST_DETERMINE_TOPIC:
+            return learner_documents(model.learner) / CACHE_EPOCH_CHANGES;
+        case REQUEST_GENERATE_SUMMARY:
+            return atomic_load(&model.collection_generation) / CACHE_EPOCH_CHANGES;
+        default:
+            return 0;
     }
+}
+
+static int learnable_topic(const char* topic) {
+    return strcmp(topic, "Necunoscut") != 0 && 
+           strcmp(topic, "Eroare la procesare") != 0;
+}
+
+// Clasificare Bayes, cu cuvintele cheie ca rezerva. Documentele clasificate
+// sunt trimise learner-ului; modelul se schimba abia cand publica lotul lor.
+static char* classify_document(TokenizationResult* tokens) {
+    int copy;
+    BayesClassifier* classifier = learner_acquire(model.learner, &copy);
+    char* topic = classify_tokens_bayes(classifier, tokens);
+    learner_release(model.learner, copy);
     
-    if (!collection) {
-        collection = (DocumentCollection*)malloc(sizeof(DocumentCollection));
-        collection->document_count = 0;
-        collection->documents = NULL;
+    if (strcmp(topic, "Necunoscut") == 0) {
+        free(topic); 
+        topic = determine_topic_tokens(tokens);
     }
     
-    while (1) {
-        ProcessingRequest request = dequeue();
-        time_t start_time = time(NULL);
-        
-        Response response;
-        response.status = STATUS_OK;
-        response.topic = NULL;
-        response.summary = NULL;
-        
+    if (learnable_topic(topic)) {
+        learner_submit(model.learner, tokens, topic);
+    }
+    return topic;
+}
 
-        collection->documents = realloc(collection->documents, 
-                                       (collection->document_count + 1) * sizeof(char*));
-        if (collection->documents) {
-            collection->documents[collection->document_count] = strdup(request.text);
-            collection->document_count++;
+// Proceseaza un singur text; topic/summary din raspuns se elibereaza de apelant.
+// Memoria temporara vine din arena thread-ului si e eliberata la final.
+// Daca example nu e NULL, primeste tokenii cu care documentul a schimbat
+// modelul (domeniul e topicul), sau NULL daca nu l-a schimbat.
+static void process_text(RequestType type, const char* text, Response* response, Arena* arena,
+                         TrainingExample** example) {
+    DocumentCollection* collection = model.collection;
+    time_t start_time = time(NULL);
+    
+    response->status = STATUS_OK;
+    response->word_count = 0;
+    response->topic = NULL;
+    response->summary = NULL;
+            
+    // O singura analiza a textului, refolosita de topic si rezumat
+    TextAnalysis* analysis = NULL;
+    if (type == REQUEST_DETERMINE_TOPIC || type == REQUEST_GENERATE_SUMMARY) {
+        analysis = analyze_text_arena(text, arena);
+        if (!analysis) {
+            response->status = STATUS_ERROR;
+            strcpy(response->error_message, "Eroare la procesare");
         }
-        
-        switch (request.type) {
+    }
+    
+    // Actualizare corpus, doar pentru tipurile configurate
+    TokenizationResult* corpus_tokens = NULL;
+    if (corpus_feeds(type)) {
+        corpus_tokens = analysis ? analysis->tokens : tokenize_text_arena(text, arena);
+    }
+    update_corpus(type, corpus_tokens);
+    
+    if (response->status == STATUS_OK) {
+        switch (type) {
             case REQUEST_COUNT_WORDS:
-                response.word_count = count_words(request.text);
+                response->word_count = count_words(text);
                 break;
                 
-                case REQUEST_DETERMINE_TOPIC:
-                {
-                    
-                    response.topic = classify_text_bayes(classifier, request.text);
-                    
-                    
-                    if (strcmp(response.topic, "Necunoscut") == 0) {
-                        free(response.topic); 
-                        response.topic = determine_topic(request.text);
-                    }
-                    
-                    if (strcmp(response.topic, "Necunoscut") != 0 && 
-                        strcmp(response.topic, "Eroare la procesare") != 0) {
-                        train_bayes_classifier(classifier, request.text, response.topic);
-                    }
-                    break;
-                }                
+            case REQUEST_DETERMINE_TOPIC:
+                response->topic = classify_document(analysis->tokens);
+                break;
                 
             case REQUEST_GENERATE_SUMMARY:
-                
-                response.summary = generate_summary(request.text, 3, collection);
+                pthread_rwlock_rdlock(&model.collection_lock);
+                response->summary = generate_summary_analysis(text, analysis, 3, collection);
+                pthread_rwlock_unlock(&model.collection_lock);
                 break;
-
                 
             default:
-                response.status = STATUS_ERROR;
-                strcpy(response.error_message, "Tip de cerere necunoscut");
+                response->status = STATUS_ERROR;
+                strcpy(response->error_message, "Tip de cerere necunoscut");
+        }
+    }
+    
+    if (response->status == STATUS_OK && analysis) {
+        response->word_count = analysis->word_count;
+    }
+    
+    if (example) {
+        *example = NULL;
+        if (corpus_tokens || (type == REQUEST_DETERMINE_TOPIC && response->topic)) {
+            *example = create_training_example(corpus_tokens ? corpus_tokens : analysis->tokens,
+                                               response->topic ? response->topic : "");
+        }
+    }
+    arena_reset(arena);
+    
+    time_t end_time = time(NULL);
+    response->processing_time = difftime(end_time, start_time);
+}
+
+// Pentru un document gasit in cache face, cu tokenii pastrati in intrare,
+// ce ar fi facut process_text in model; preia example
+static void replay_model_updates(RequestType type, TrainingExample* example) {
+    if (corpus_feeds(type)) {
+        pthread_rwlock_wrlock(&model.collection_lock);
+        add_document_tokens(model.collection, example->tokens, example->count);
+        atomic_fetch_add(&model.collection_generation, 1);
+        pthread_rwlock_unlock(&model.collection_lock);
+    }
+    if (type == REQUEST_DETERMINE_TOPIC && learnable_topic(example->domain)) {
+        learner_submit_example(model.learner, example);
+    } else {
+        free(example);
+    }
+}
+
+// process_text cu cache-ul de rezultate in fata. Un rezultat ramane valid
+// pana la sfarsitul epocii in care a fost calculat (vezi model_epoch), deci
+// ignora cel mult CACHE_EPOCH_CHANGES modificari ale modelului. Implicit
+// o copie gasita in cache nu mai e adaugata in corpus si nu mai antreneaza;
+// cu config.cache_hits_learn intrarea pastreaza si tokenii documentului,
+// iar copia schimba modelul ca o cerere calculata, fara o noua tokenizare.
+static void process_text_cached(RequestType type, const char* text, Response* response, Arena* arena) {
+    if (!result_cache) {
+        process_text(type, text, response, arena, NULL);
+        return;
+    }
+    
+    CacheKey key;
+    cache_key(type, text, strlen(text), &key);
+    
+    // documentele iesite din fereastra de timp schimba corpusul
+    if (type == REQUEST_GENERATE_SUMMARY) {
+        update_corpus(type, NULL);
+    }
+    
+    int learn = config.cache_hits_learn && (type == REQUEST_DETERMINE_TOPIC || corpus_feeds(type));
+    TrainingExample* example = NULL;
+    
+    uint64_t epoch = model_epoch(type);
+    if (result_cache_lookup(result_cache, &key, epoch, response, learn ? &example : NULL)) {
+        if (example) {
+            replay_model_updates(type, example);
         }
+        response->processing_time = 0.0;
+        return;
+    }
+    
+    process_text(type, text, response, arena, learn ? &example : NULL);
+    
+    // calculat cu modelul din epoca citita inainte; daca intre timp epoca
+    // s-a schimbat, rezultatul ar fi invalid la prima cautare
+    if (model_epoch(type) == epoch) {
+        result_cache_store(result_cache, &key, epoch, response, example);
+    } else {
+        free(example);
+    }
+}
+
+// Un lot e o singura intrare in coada si un singur raspuns; textele
+// elementelor sunt citite direct din payload
+static char* process_batch(ProcessingRequest* request, Response* batch, size_t* length, Arena* arena) {
+    // numarul declarat de elemente, verificat apoi de decode_batch_request
+    unsigned int declared = batch_item_count(request->text->data, request->text->length, request->version);
+    int max_items = declared < MAX_BATCH_ITEMS ? (int)declared : MAX_BATCH_ITEMS;
+    
+    BatchItem* items = (BatchItem*)malloc((max_items ? max_items : 1) * sizeof(BatchItem));
+    int count = items ? decode_batch_request(request->text->data, request->text->length,
+                                               request->version, items, max_items) : -1;
+    
+    if (count < 0) {
+        free(items);
+        batch->status = STATUS_ERROR;
+        strcpy(batch->error_message, "Lot invalid");
+        return encode_batch_response(batch, NULL, 0, length);
+    }
+    
+    Response* responses = (Response*)malloc((count ? count : 1) * sizeof(Response));
+    if (!responses) {
+        free(items);
+        batch->status = STATUS_ERROR;
+        strcpy(batch->error_message, "Eroare la procesare");
+        return encode_batch_response(batch, NULL, 0, length);
+    }
+    
+    for (int i = 0; i < count; i++) {
+        process_text_cached(items[i].type, items[i].text, &responses[i], arena);
+    }
+    
+    batch->status = STATUS_OK;
+    char* data = encode_batch_response(batch, responses, count, length);
+    
+    for (int i = 0; i < count; i++) {
+        free(responses[i].topic);
+        free(responses[i].summary);
+    }
+    free(responses);
+    free(items);
+    return data;
+}
+
+static TextStream* create_text_stream(const RequestHeader* request) {
+    RequestType type = request->type;
+    TextStream* stream = (TextStream*)calloc(1, sizeof(TextStream));
+    if (!stream) {
+        return NULL;
+    }
+    
+    int options = 0;
+    if (type == REQUEST_DETERMINE_TOPIC || corpus_feeds(type)) {
+        options |= STREAM_TOKENS;
+    }
+    if (type == REQUEST_GENERATE_SUMMARY) {
+        options |= STREAM_SENTENCES;
+    }
+    
+    stream->analysis = stream_analysis_create(options);
+    if (!stream->analysis) {
+        free(stream);
+        return NULL;
+    }
+    
+    atomic_init(&stream->refs, 1);
+    pthread_mutex_init(&stream->lock, NULL);
+    stream->type = type;
+    stream->version = request->version;
+    stream->flags = request->flags;
+    stream->request_id = request->request_id;
+    stream->start_time = time(NULL);
+    return stream;
+}
+
+static void release_text_stream(TextStream* stream) {
+    if (atomic_fetch_sub_explicit(&stream->refs, 1, memory_order_acq_rel) != 1) {
+        return;
+    }
+    
+    while (stream->head) {
+        Buffer* next = stream->head->next;
+        buffer_release(stream->head);
+        stream->head = next;
+    }
+    stream_analysis_free(stream->analysis);
+    pthread_mutex_destroy(&stream->lock);
+    free(stream);
+}
+
+// Dupa ultima bucata nu mai exista alte intrari pentru flux, deci analiza
+// se termina fara lock
+static void finish_stream(TextStream* stream, Response* response) {
+    StreamAnalysis* analysis = stream->analysis;
+    
+    response->version = stream->version;
+    response->type = stream->type;
+    response->flags = stream->flags;
+    response->request_id = stream->request_id;
+    response->status = STATUS_OK;
+    response->word_count = 0;
+    response->topic = NULL;
+    response->summary = NULL;
+    
+    if (!analysis || stream_analysis_finish(analysis) < 0) {
+        response->status = STATUS_ERROR;
+        strcpy(response->error_message, "Eroare la procesare");
+    } else {
+        TokenizationResult* tokens = stream_analysis_tokens(analysis);
+        update_corpus(stream->type, corpus_feeds(stream->type) ? tokens : NULL);
         
-        if (response.status == STATUS_OK && request.type != REQUEST_COUNT_WORDS) {
-            response.word_count = count_words(request.text);
+        if (stream->type == REQUEST_DETERMINE_TOPIC) {
+            response->topic = classify_document(tokens);
+        } else if (stream->type == REQUEST_GENERATE_SUMMARY) {
+            pthread_rwlock_rdlock(&model.collection_lock);
+            response->summary = stream_analysis_summary(analysis, 3, model.collection);
+            pthread_rwlock_unlock(&model.collection_lock);
         }
+        response->word_count = stream_analysis_word_count(analysis);
+    }
+    
+    // de la prima bucata, deci include si transferul documentului
+    response->processing_time = difftime(time(NULL), stream->start_time);
+}
+
+// Analizeaza urmatoarea bucata a fluxului. Intoarce 1 cand bucata a fost
+// cea finala si raspunsul e in response.
+static int process_stream_chunk(TextStream* stream, Response* response) {
+    pthread_mutex_lock(&stream->lock);
+    Buffer* chunk = stream->head;
+    stream->head = chunk->next;
+    if (!stream->head) {
+        stream->tail = NULL;
+    }
+    chunk->next = NULL;
+    
+    int last = chunk->length == 0;
+    if (!last && stream->analysis &&
+        stream_analysis_feed(stream->analysis, chunk->data, chunk->length) < 0) {
+        stream_analysis_free(stream->analysis);
+        stream->analysis = NULL;
+    }
+    pthread_mutex_unlock(&stream->lock);
+    
+    buffer_release(chunk);
+    
+    if (last) {
+        finish_stream(stream, response);
+    }
+    return last;
+}
+
+// memoria temporara a unei cereri (tokeni, propozitii), refolosita de fiecare worker
+#define WORKER_ARENA_BLOCK_SIZE (256 * 1024)
+
+void* processing_thread(void* arg) {
+    (void)arg;
+    Arena* arena = arena_create(WORKER_ARENA_BLOCK_SIZE);
+    if (!arena) {
+        fprintf(stderr, "Eroare la alocarea arenei de procesare\n");
+        return NULL;
+    }
+    
+    while (1) {
+        ProcessingRequest request = dequeue(&request_queue);
         
-        time_t end_time = time(NULL);
-        response.processing_time = difftime(end_time, start_time);
+        Response response;
+        response.version = request.version;
+        response.type = request.type;
+        response.flags = request.flags;
+        response.request_id = request.request_id;
         
-        send_response(request.client_fd, &response);
+        char* data;
+        size_t length = 0;
+        if (request.stream) {
+            int last = process_stream_chunk(request.stream, &response);
+            release_text_stream(request.stream);
+            if (!last) {
+                post_chunk_done(request.client_fd);
+                continue;
+            }
+            data = encode_response(&response, &length);
+            free(response.topic);
+            free(response.summary);
+        } else if (request.type == REQUEST_BATCH) {
+            data = process_batch(&request, &response, &length, arena);
+        } else {
+            process_text_cached(request.type, request.text->data, &response, arena);
+            data = encode_response(&response, &length);
+            if (response.topic) free(response.topic);
+            if (response.summary) free(response.summary);
+        }
         
+        post_completion(request.client_fd, data, length);
         
-        free(request.text);
-        if (response.topic) free(response.topic);
-        if (response.summary) free(response.summary);
+        buffer_release(request.text);
     }
     
+    arena_destroy(arena);
     return NULL;
 }
 
@@ -216,45 +717,428 @@ void remove_client(int client_fd) {
     pthread_mutex_unlock(&clients_mutex);
 }
 
-void* client_handler(void* arg) {
-    int client_fd = *((int*)arg);
-    free(arg);
+static void track_request(int client_fd) {
+    pthread_mutex_lock(&clients_mutex);
+    for (int i = 0; i < client_count; i++) {
+        if (clients[i].fd == client_fd) {
+            clients[i].request_count++;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&clients_mutex);
+}
+
+// Bucata dintr-un flux: o adaugam la document si punem o intrare in coada.
+// Cat timp sunt prea multe bucati la procesare, conexiunea sta pe pauza,
+// deci memoria unui flux nu depinde de lungimea documentului.
+static int handle_stream_chunk(Connection* conn, const RequestHeader* request, Buffer* text) {
+    if (!conn->stream) {
+        if (request->type < REQUEST_COUNT_WORDS || request->type > REQUEST_GENERATE_SUMMARY ||
+            !(conn->stream = create_text_stream(request))) {
+            buffer_release(text);
+            return -1;
+        }
+    } else if (request->type != conn->stream->type ||
+               request->request_id != conn->stream->request_id) {
+        // o bucata din alt document cat timp fluxul e deschis
+        buffer_release(text);
+        return -1;
+    }
+    
+    TextStream* stream = conn->stream;
+    int last = text->length == 0;
+    
+    pthread_mutex_lock(&stream->lock);
+    if (stream->tail) {
+        stream->tail->next = text;
+    } else {
+        stream->head = text;
+    }
+    stream->tail = text;
+    pthread_mutex_unlock(&stream->lock);
+    
+    ProcessingRequest proc_req;
+    proc_req.client_fd = conn->fd;
+    proc_req.type = request->type;
+    proc_req.version = request->version;
+    proc_req.flags = request->flags;
+    proc_req.request_id = request->request_id;
+    proc_req.text = NULL;
+    proc_req.stream = stream;
+    
+    conn->pending++;
+    
+    if (last) {
+        // referinta reactorului trece la ultima intrare
+        conn->stream = NULL;
+        track_request(conn->fd);
+    } else {
+        atomic_fetch_add_explicit(&stream->refs, 1, memory_order_relaxed);
+        conn->queued_chunks++;
+    }
+    
+    enqueue(&request_queue, proc_req);
+    return 0;
+}
+
+// Cadru v2 cu o versiune pe care nu o cunoastem: raspundem direct, in
+// PROTOCOL_VERSION, ca clientul sa afle ce versiune vorbeste serverul
+static int reject_version(Connection* conn, const RequestHeader* request) {
+    Response response;
+    response.version = PROTOCOL_VERSION;
+    response.type = request->type;
+    response.flags = 0;
+    response.request_id = request->request_id;
+    response.status = STATUS_ERROR;
+    snprintf(response.error_message, MAX_ERROR_MSG,
+             "Versiune de protocol nesuportată: %d (serverul folosește %d)",
+             request->version, PROTOCOL_VERSION);
+    
+    size_t length;
+    char* data = encode_response(&response, &length);
+    int result = data ? connection_send(conn, data, length) : -1;
+    free(data);
+    return result;
+}
+
+// Trimite cererea la procesare (o versiune necunoscuta primeste raspuns direct)
+static int dispatch_request(Connection* conn, const RequestHeader* request, Buffer* text) {
+    if (request->version != 1 && request->version != PROTOCOL_VERSION) {
+        buffer_release(text);
+        return reject_version(conn, request);
+    }
+    
+    if (request->flags & REQUEST_FLAG_STREAM) {
+        return handle_stream_chunk(conn, request, text);
+    }
+    
+    // cat timp un flux e deschis, conexiunea accepta doar bucatile lui
+    if (conn->stream) {
+        buffer_release(text);
+        return -1;
+    }
+    
+    ProcessingRequest proc_req;
+    proc_req.client_fd = conn->fd;
+    proc_req.type = request->type;
+    proc_req.version = request->version;
+    proc_req.flags = request->flags;
+    proc_req.request_id = request->request_id;
+    proc_req.text = text;
+    proc_req.stream = NULL;
+    
+    conn->pending++;
+    
+    // Add in coada de procesare (blocheaza reactorul cat timp coada e plina)
+    enqueue(&request_queue, proc_req);
+    
+    track_request(conn->fd);
+    return 0;
+}
+
+// Citirea de pe conexiune se opreste cat timp e depasita una din limite
+static int must_pause(const Connection* conn) {
+    return conn->queued_chunks >= MAX_QUEUED_CHUNKS ||
+           conn->pending >= MAX_PENDING_REQUESTS ||
+           conn->output_length - conn->output_sent >= MAX_OUTPUT_BYTES;
+}
+
+// Cerere completa primita de reactor: o trimitem la procesare. Cererile
+// deja citite se predau si pe pauza; connection_read nu mai citeste altele.
+static int handle_request(Connection* conn, const RequestHeader* request, Buffer* text) {
+    int result = dispatch_request(conn, request, text);
+    if (must_pause(conn)) {
+        conn->paused = 1;
+    }
+    return result;
+}
+
+static int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) {
+        return -1;
+    }
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+static int register_connection(int client_fd) {
+    if (client_fd >= connection_slots) {
+        int slots = connection_slots ? connection_slots : 1024;
+        while (slots <= client_fd) {
+            slots *= 2;
+        }
+        
+        Connection** grown = (Connection**)realloc(connections, slots * sizeof(Connection*));
+        if (!grown) {
+            return -1;
+        }
+        memset(grown + connection_slots, 0, (slots - connection_slots) * sizeof(Connection*));
+        connections = grown;
+        connection_slots = slots;
+    }
     
-    // Bucla pentru gestionarea mai multor cereri de la acc client
+    Connection* conn = create_connection(client_fd);
+    if (!conn) {
+        return -1;
+    }
+    
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.fd = client_fd;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client_fd, &event) < 0) {
+        free_connection(conn);
+        return -1;
+    }
+    
+    connections[client_fd] = conn;
+    return 0;
+}
+
+// Clientul a plecat. Fd-ul ramane deschis (si deci nerefolosit) pana se
+// termina cererile lui aflate la procesare.
+static void close_connection(Connection* conn) {
+    if (!conn->closing) {
+        conn->closing = 1;
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+        // ELIMINARE CLIENT LA DECONECTARE
+        remove_client(conn->fd);
+        
+        // bucatile deja in coada pastreaza fluxul pana sunt consumate
+        if (conn->stream) {
+            release_text_stream(conn->stream);
+            conn->stream = NULL;
+        }
+    }
+    
+    if (conn->pending == 0) {
+        connections[conn->fd] = NULL;
+        close(conn->fd);
+        free_connection(conn);
+    }
+}
+
+static void accept_clients(int tcp_fd) {
     while (1) {
-        // Primire cerere
-        Request req;
-        if (receive_request(client_fd, &req) < 0) {
-            // ELIMINARE CLIENT LA DECONECTARE
-            remove_client(client_fd);
-            close(client_fd);
-            return NULL;
+        struct sockaddr_in client_addr;
+        socklen_t client_len = sizeof(client_addr);
+        
+        int client_fd = accept(tcp_fd, (struct sockaddr*)&client_addr, &client_len);
+        if (client_fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                perror("Eroare la accept pentru client normal");
+            }
+            return;
         }
         
-        // Creare cerere de procesare
-        ProcessingRequest proc_req;
-        proc_req.client_fd = client_fd;
-        proc_req.type = req.type;
-        proc_req.text = strdup(req.text);
+        // raspunsurile sunt cadre mici, scrise o singura data: fara Nagle
+        enable_tcp_nodelay(client_fd);
         
-        // Add in coada de procesare
-        enqueue(proc_req);
+        if (set_nonblocking(client_fd) < 0 || register_connection(client_fd) < 0) {
+            perror("Eroare la înregistrarea clientului");
+            close(client_fd);
+            continue;
+        }
         
-        // Actualizare info client
         pthread_mutex_lock(&clients_mutex);
-        for (int i = 0; i < client_count; i++) {
-            if (clients[i].fd == client_fd) {
-                clients[i].request_count++;
-                break;
-            }
+        if (client_count < MAX_CLIENTS) {
+            clients[client_count].fd = client_fd;
+            inet_ntop(AF_INET, &client_addr.sin_addr, clients[client_count].address, sizeof(clients[client_count].address));
+            clients[client_count].connect_time = time(NULL);
+            clients[client_count].request_count = 0;
+            client_count++;
         }
         pthread_mutex_unlock(&clients_mutex);
     }
+}
+
+// Dupa o bucata terminata, un raspuns adaugat sau output trimis: pune
+// citirea pe pauza sau o reia daca limitele nu mai sunt depasite. Socket-ul
+// e edge-triggered, deci datele ramase in el nu mai genereaza un eveniment.
+static void update_reading(Connection* conn, char* read_buffer) {
+    if (!conn->paused) {
+        conn->paused = must_pause(conn);
+        return;
+    }
+    if (must_pause(conn)) {
+        return;
+    }
     
-    return NULL;
+    conn->paused = 0;
+    if (connection_read(conn, read_buffer, READ_BUFFER_SIZE, handle_request) < 0) {
+        close_connection(conn);
+    }
+}
+
+// Trimite raspunsurile terminate de thread-urile de procesare
+static void deliver_completions(char* read_buffer) {
+    uint64_t count;
+    if (read(completions.event_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+        perror("Eroare la citirea eventfd");
+    }
+    
+    pthread_mutex_lock(&completions.mutex);
+    Completion* completion = completions.head;
+    completions.head = NULL;
+    completions.tail = NULL;
+    pthread_mutex_unlock(&completions.mutex);
+    
+    while (completion) {
+        Completion* next = completion->next;
+        Connection* conn = connections[completion->client_fd];
+        
+        conn->pending--;
+        if (conn->closing) {
+            close_connection(conn);
+        } else if (completion->chunk_done) {
+            conn->queued_chunks--;
+            update_reading(conn, read_buffer);
+        } else if (!completion->data || connection_send(conn, completion->data, completion->length) < 0) {
+            close_connection(conn);
+        } else {
+            update_reading(conn, read_buffer);
+        }
+        
+        free(completion->data);
+        free(completion);
+        completion = next;
+    }
+}
+
+static void handle_client_event(Connection* conn, uint32_t events, char* read_buffer) {
+    int resumed = 0;
+    
+    if (events & EPOLLOUT) {
+        if (connection_flush(conn) < 0) {
+            close_connection(conn);
+            return;
+        }
+        // clientul a citit raspunsuri: poate trimite din nou cereri
+        if (conn->paused && !must_pause(conn)) {
+            conn->paused = 0;
+            resumed = 1;
+        }
+    }
+    
+    if (resumed || (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+        if (connection_read(conn, read_buffer, READ_BUFFER_SIZE, handle_request) < 0) {
+            close_connection(conn);
+        }
+    }
+}
+
+// Ridica limita de descriptori deschisi pana la maximul permis
+static void raise_fd_limit() {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
 }
 
 // Administrare client 
+// Scrie copia publicata a modelului, ca un cititor: clasificarea continua,
+// doar urmatorul lot al learner-ului asteapta. Intoarce -1 (errno) la eroare.
+static int save_model(ModelStats* stats) {
+    // generatia de dinainte: cel mult se mai salveaza o data degeaba
+    uint64_t generation = learner_generation(model.learner);
+    int copy;
+    BayesClassifier* classifier = learner_acquire(model.learner, &copy);
+    double start = monotonic_seconds();
+    long long bytes = save_model_snapshot(classifier, config.strip_diacritics, config.model_path);
+    stats->seconds = monotonic_seconds() - start;
+    stats->vocabulary = classifier->vocabulary.count;
+    stats->documents = classifier->total_documents;
+    learner_release(model.learner, copy);
+    
+    if (bytes < 0) {
+        return -1;
+    }
+    stats->bytes = bytes;
+    
+    pthread_mutex_lock(&model_saver.mutex);
+    model_saver.saved_generation = generation;
+    model_saver.stats = *stats;
+    pthread_mutex_unlock(&model_saver.mutex);
+    return 0;
+}
+
+void* model_saver_thread(void* arg) {
+    (void)arg;
+    while (1) {
+        int pending[MAX_PENDING_SAVES];
+        int pending_count;
+        
+        pthread_mutex_lock(&model_saver.mutex);
+        if (config.model_save_interval > 0) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += config.model_save_interval;
+            while (model_saver.pending_count == 0 &&
+                   pthread_cond_timedwait(&model_saver.cond, &model_saver.mutex, &deadline) != ETIMEDOUT) {
+            }
+        } else {
+            while (model_saver.pending_count == 0) {
+                pthread_cond_wait(&model_saver.cond, &model_saver.mutex);
+            }
+        }
+        pending_count = model_saver.pending_count;
+        memcpy(pending, model_saver.pending, pending_count * sizeof(int));
+        model_saver.pending_count = 0;
+        uint64_t saved_generation = model_saver.saved_generation;
+        pthread_mutex_unlock(&model_saver.mutex);
+        
+        // periodic se salveaza doar un model schimbat; la cerere, oricum
+        if (pending_count == 0 && learner_generation(model.learner) == saved_generation) {
+            continue;
+        }
+        
+        ModelStats stats;
+        memset(&stats, 0, sizeof(stats));
+        int result = save_model(&stats);
+        int error = errno;
+        if (result < 0) {
+            fprintf(stderr, "Eroare la salvarea modelului în %s: %s\n", config.model_path, strerror(error));
+        }
+        
+        AdminResponse admin_resp;
+        memset(&admin_resp, 0, sizeof(AdminResponse));
+        admin_resp.status = result < 0 ? STATUS_ERROR : STATUS_OK;
+        admin_resp.model = stats;
+        if (result < 0) {
+            snprintf(admin_resp.error_message, sizeof(admin_resp.error_message),
+                     "Eroare la salvarea modelului: %s", strerror(error));
+        }
+        for (int i = 0; i < pending_count; i++) {
+            if (send_admin_response(pending[i], &admin_resp) < 0) {
+                perror("Eroare la trimiterea răspunsului administrativ");
+            }
+            close(pending[i]);
+        }
+    }
+    return NULL;
+}
+
+// Preda cererea thread-ului de salvare, care raspunde si inchide socket-ul;
+// -1 daca nu poate (raspunsul il da apelantul)
+static int queue_model_save(int admin_fd, AdminResponse* admin_resp) {
+    if (!config.model_path) {
+        strcpy(admin_resp->error_message, "Serverul nu are un fișier de model (--model)");
+        return -1;
+    }
+    
+    pthread_mutex_lock(&model_saver.mutex);
+    if (model_saver.pending_count == MAX_PENDING_SAVES) {
+        pthread_mutex_unlock(&model_saver.mutex);
+        strcpy(admin_resp->error_message, "Prea multe salvări ale modelului în așteptare");
+        return -1;
+    }
+    model_saver.pending[model_saver.pending_count++] = admin_fd;
+    pthread_cond_signal(&model_saver.cond);
+    pthread_mutex_unlock(&model_saver.mutex);
+    return 0;
+}
+
 void handle_admin_client(int admin_fd) {
     AdminRequest admin_req;
     if (receive_admin_request(admin_fd, &admin_req) < 0) {
@@ -275,19 +1159,33 @@ void handle_admin_client(int admin_fd) {
                 admin_resp.clients[i] = clients[i];
             }
             
-            pthread_mutex_lock(&request_queue.mutex);
-            admin_resp.queue_size = request_queue.count;
-            admin_resp.queue_capacity = MAX_QUEUE_SIZE;
-            pthread_mutex_unlock(&request_queue.mutex);
+            admin_resp.queue_size = queue_size(&request_queue);
+            admin_resp.queue_capacity = queue_capacity(&request_queue);
             pthread_mutex_unlock(&clients_mutex);
             break;
             
         case ADMIN_GET_QUEUE_STATUS:
             admin_resp.client_count = 0; 
-            pthread_mutex_lock(&request_queue.mutex);
-            admin_resp.queue_size = request_queue.count;
-            admin_resp.queue_capacity = MAX_QUEUE_SIZE;
-            pthread_mutex_unlock(&request_queue.mutex);
+            admin_resp.queue_size = queue_size(&request_queue);
+            admin_resp.queue_capacity = queue_capacity(&request_queue);
+            break;
+            
+        case ADMIN_GET_CACHE_STATS:
+            if (result_cache) {
+                result_cache_stats(result_cache, &admin_resp.cache);
+            }
+            break;
+            
+        case ADMIN_GET_LEARNER_STATS:
+            learner_stats(model.learner, &admin_resp.learner);
+            break;
+            
+        case ADMIN_SAVE_MODEL:
+            // salvarea unui model mare nu blocheaza reactorul
+            if (queue_model_save(admin_fd, &admin_resp) == 0) {
+                return;
+            }
+            admin_resp.status = STATUS_ERROR;
             break;
             
         default:
@@ -303,13 +1201,141 @@ void handle_admin_client(int admin_fd) {
     close(admin_fd);
 }
 
-int main() {
+void print_usage() {
+    printf("Utilizare: server_bin [OPTIUNI]\n");
+    printf("Optiuni:\n");
+    printf("  --corpus-max-docs N      - Numărul maxim de documente din corpus (0 = nelimitat, implicit %d)\n",
+           DEFAULT_CORPUS_MAX_DOCUMENTS);
+    printf("  --corpus-max-bytes N     - Memoria maximă a corpusului în bytes (0 = nelimitat, implicit %d)\n",
+           DEFAULT_CORPUS_MAX_BYTES);
+    printf("  --corpus-window SECUNDE  - Elimină documentele mai vechi de atât (0 = dezactivat)\n");
+    printf("  --corpus-feed TIPURI     - Cererile care alimentează corpusul: count,topic,summary sau none\n");
+    printf("                             (implicit topic,summary)\n");
+    printf("  --workers N              - Thread-uri de procesare (implicit: câte unul pe nucleu)\n");
+    printf("  --cache-bytes N          - Memoria cache-ului de rezultate în bytes (0 = dezactivat, implicit %d)\n",
+           DEFAULT_CACHE_BYTES);
+    printf("  --cache-hits MOD         - skip: documentele găsite în cache doar primesc rezultatul,\n");
+    printf("                             modelul nu se schimbă (implicit)\n");
+    printf("                             learn: antrenează clasificatorul și intră în corpus, ca cele\n");
+    printf("                             calculate, din tokenii păstrați în cache\n");
+    printf("  --diacritics MOD         - keep: tokenii păstrează diacriticele (implicit)\n");
+    printf("                             strip: tokenii pierd diacriticele (ă -> a, ș -> s)\n");
+    printf("  --keywords FIȘIER        - Cuvinte cheie pentru topic, în plus față de cele incorporate\n");
+    printf("                             (se poate repeta, maxim %d fișiere)\n", MAX_KEYWORD_FILES);
+    printf("  --model FIȘIER           - Snapshot-ul modelului Bayes: încărcat la pornire dacă există,\n");
+    printf("                             salvat periodic și la cererea administratorului\n");
+    printf("  --model-save-interval SECUNDE - Salvarea periodică a modelului, dacă s-a schimbat\n");
+    printf("                             (0 = doar la cerere, implicit %d)\n", DEFAULT_MODEL_SAVE_INTERVAL);
+    printf("  --learner-queue N        - Documente care pot aștepta antrenarea în fundal (implicit %d)\n",
+           DEFAULT_LEARNER_QUEUE);
+}
+
+// "count,topic,summary" -> masca REQUEST_TYPE_BIT
+static int parse_corpus_feed(const char* list) {
+    if (strcmp(list, "none") == 0) {
+        return 0;
+    }
+    
+    int mask = 0;
+    char buffer[128];
+    strncpy(buffer, list, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    
+    for (char* item = strtok(buffer, ","); item; item = strtok(NULL, ",")) {
+        if (strcmp(item, "count") == 0) {
+            mask |= REQUEST_TYPE_BIT(REQUEST_COUNT_WORDS);
+        } else if (strcmp(item, "topic") == 0) {
+            mask |= REQUEST_TYPE_BIT(REQUEST_DETERMINE_TOPIC);
+        } else if (strcmp(item, "summary") == 0) {
+            mask |= REQUEST_TYPE_BIT(REQUEST_GENERATE_SUMMARY);
+        } else {
+            return -1;
+        }
+    }
+    return mask;
+}
+
+static int parse_arguments(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            return -1;
+        }
+        
+        const char* value = argv[++i];
+        if (strcmp(argv[i - 1], "--corpus-max-docs") == 0) {
+            config.corpus_max_documents = atoi(value);
+        } else if (strcmp(argv[i - 1], "--corpus-max-bytes") == 0) {
+            config.corpus_max_bytes = strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i - 1], "--corpus-window") == 0) {
+            config.corpus_max_age = atoi(value);
+        } else if (strcmp(argv[i - 1], "--cache-bytes") == 0) {
+            config.cache_bytes = strtoull(value, NULL, 10);
+        } else if (strcmp(argv[i - 1], "--cache-hits") == 0) {
+            if (strcmp(value, "learn") == 0) {
+                config.cache_hits_learn = 1;
+            } else if (strcmp(value, "skip") == 0) {
+                config.cache_hits_learn = 0;
+            } else {
+                return -1;
+            }
+        } else if (strcmp(argv[i - 1], "--workers") == 0) {
+            config.workers = atoi(value);
+            if (config.workers < 0) {
+                return -1;
+            }
+        } else if (strcmp(argv[i - 1], "--diacritics") == 0) {
+            if (strcmp(value, "keep") == 0) {
+                config.strip_diacritics = 0;
+            } else if (strcmp(value, "strip") == 0) {
+                config.strip_diacritics = 1;
+            } else {
+                return -1;
+            }
+        } else if (strcmp(argv[i - 1], "--keywords") == 0) {
+            if (config.keyword_file_count == MAX_KEYWORD_FILES) {
+                return -1;
+            }
+            config.keyword_files[config.keyword_file_count++] = value;
+        } else if (strcmp(argv[i - 1], "--model") == 0) {
+            config.model_path = value;
+        } else if (strcmp(argv[i - 1], "--learner-queue") == 0) {
+            config.learner_queue = atoi(value);
+            if (config.learner_queue <= 0) {
+                return -1;
+            }
+        } else if (strcmp(argv[i - 1], "--model-save-interval") == 0) {
+            config.model_save_interval = atoi(value);
+            if (config.model_save_interval < 0) {
+                return -1;
+            }
+        } else if (strcmp(argv[i - 1], "--corpus-feed") == 0) {
+            config.corpus_feed = parse_corpus_feed(value);
+            if (config.corpus_feed < 0) {
+                return -1;
+            }
+        } else {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     int tcp_fd, unix_fd;
     struct sockaddr_in tcp_addr;
     struct sockaddr_un unix_addr;
     
+    if (parse_arguments(argc, argv) < 0) {
+        print_usage();
+        return 1;
+    }
     
-    init_queue();
+    raise_fd_limit();
+    
+    if (init_queue(&request_queue, MAX_QUEUE_SIZE) < 0) {
+        fprintf(stderr, "Eroare la inițializarea cozii de procesare\n");
+        exit(1);
+    }
     
     
     tcp_fd = socket(AF_INET, SOCK_STREAM, 0);
@@ -330,7 +1356,12 @@ int main() {
         exit(1);
     }
     
-    listen(tcp_fd, 5);
+    if (set_nonblocking(tcp_fd) < 0) {
+        perror("Eroare la configurarea socket-ului TCP");
+        exit(1);
+    }
+    
+    listen(tcp_fd, SOMAXCONN);
     
     unix_fd = socket(AF_UNIX, SOCK_STREAM, 0);
     if (unix_fd < 0) {
@@ -353,69 +1384,116 @@ int main() {
 
 
 
-    pthread_t processing_tid;
-    pthread_create(&processing_tid, NULL, processing_thread, NULL);
+    // inainte de antrenarea initiala, ca tot modelul sa foloseasca aceiasi tokeni
+    set_strip_diacritics(config.strip_diacritics);
+    
+    int keyword_count = load_topic_keywords(config.keyword_files, config.keyword_file_count);
+    if (keyword_count < 0) {
+        fprintf(stderr, "Eroare la încărcarea cuvintelor cheie\n");
+        exit(1);
+    }
+    printf("Cuvinte cheie pentru topic: %d\n", keyword_count);
+    
+    if (init_shared_model() < 0) {
+        fprintf(stderr, "Eroare la inițializarea modelului\n");
+        exit(1);
+    }
+    
+    result_cache = result_cache_create(config.cache_bytes);
+    if (config.cache_bytes > 0 && !result_cache) {
+        fprintf(stderr, "Eroare la alocarea cache-ului de rezultate\n");
+        exit(1);
+    }
+    
+    if (config.workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        config.workers = cpus > 0 ? (int)cpus : 1;
+    }
+    
+    for (int i = 0; i < config.workers; i++) {
+        pthread_t processing_tid;
+        if (pthread_create(&processing_tid, NULL, processing_thread, NULL) != 0) {
+            perror("Eroare la crearea thread-ului de procesare");
+            exit(1);
+        }
+        pthread_detach(processing_tid);
+    }
+    
+    if (config.model_path) {
+        pthread_t saver_tid;
+        if (pthread_create(&saver_tid, NULL, model_saver_thread, NULL) != 0) {
+            perror("Eroare la crearea thread-ului de salvare a modelului");
+            exit(1);
+        }
+        pthread_detach(saver_tid);
+    }
+    
+    completions.event_fd = eventfd(0, EFD_NONBLOCK);
+    epoll_fd = epoll_create1(0);
+    if (completions.event_fd < 0 || epoll_fd < 0) {
+        perror("Eroare la crearea reactorului epoll");
+        exit(1);
+    }
     
-    struct pollfd fds[2];
-    fds[0].fd = tcp_fd;
-    fds[0].events = POLLIN;
-    fds[1].fd = unix_fd;
-    fds[1].events = POLLIN;
+    // socket-urile de ascultare si eventfd-ul sunt level-triggered;
+    // clientii sunt edge-triggered (vezi register_connection)
+    int listen_fds[3] = { tcp_fd, unix_fd, completions.event_fd };
+    for (int i = 0; i < 3; i++) {
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = listen_fds[i];
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fds[i], &event) < 0) {
+            perror("Eroare la epoll_ctl");
+            exit(1);
+        }
+    }
+    
+    char* read_buffer = (char*)malloc(READ_BUFFER_SIZE);
+    if (!read_buffer) {
+        fprintf(stderr, "Eroare la alocarea buffer-ului de citire\n");
+        exit(1);
+    }
+    
+    struct epoll_event events[MAX_EVENTS];
     
     printf("Serverul așteaptă conexiuni...\n");
     
     while (1) {
-        int poll_result = poll(fds, 2, -1);
+        int ready = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
         
-        if (poll_result < 0) {
-            perror("Eroare la poll");
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            perror("Eroare la epoll_wait");
             break;
         }
         
-        if (fds[0].revents & POLLIN) {
-            struct sockaddr_in client_addr;
-            socklen_t client_len = sizeof(client_addr);
-            
-            int* client_fd = malloc(sizeof(int));
-            *client_fd = accept(tcp_fd, (struct sockaddr*)&client_addr, &client_len);
-            
-            if (*client_fd < 0) {
-                perror("Eroare la accept pentru client normal");
-                free(client_fd);
-                continue;
-            }
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
             
-            pthread_mutex_lock(&clients_mutex);
-            if (client_count < MAX_CLIENTS) {
-                clients[client_count].fd = *client_fd;
-                inet_ntop(AF_INET, &client_addr.sin_addr, clients[client_count].address, sizeof(clients[client_count].address));
-                clients[client_count].connect_time = time(NULL);
-                clients[client_count].request_count = 0;
-                client_count++;
-            }
-            pthread_mutex_unlock(&clients_mutex);
-            
-            pthread_t client_tid;
-            pthread_create(&client_tid, NULL, client_handler, client_fd);
-            pthread_detach(client_tid);
-        }
-        
-        if (fds[1].revents & POLLIN) {
-            struct sockaddr_un admin_addr;
-            socklen_t admin_len = sizeof(admin_addr);
-            
-            int admin_fd = accept(unix_fd, (struct sockaddr*)&admin_addr, &admin_len);
-            
-            if (admin_fd < 0) {
-                perror("Eroare la accept pentru client de administrare");
-                continue;
+            if (fd == tcp_fd) {
+                accept_clients(tcp_fd);
+            } else if (fd == unix_fd) {
+                struct sockaddr_un admin_addr;
+                socklen_t admin_len = sizeof(admin_addr);
+                
+                int admin_fd = accept(unix_fd, (struct sockaddr*)&admin_addr, &admin_len);
+                
+                if (admin_fd < 0) {
+                    perror("Eroare la accept pentru client de administrare");
+                    continue;
+                }
+                
+                handle_admin_client(admin_fd);
+            } else if (fd == completions.event_fd) {
+                deliver_completions(read_buffer);
+            } else if (fd < connection_slots && connections[fd]) {
+                handle_client_event(connections[fd], events[i].events, read_buffer);
             }
-            
-
-            handle_admin_client(admin_fd);
         }
     }
     
+    free(read_buffer);
+    close(epoll_fd);
     close(tcp_fd);
     close(unix_fd);
     unlink(UNIX_SOCKET_PATH);
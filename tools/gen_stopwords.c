@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "../common/stopword_hash.h"
+
+/* Genereaza common/stopwords_table.h: o tabela de hash perfect pentru
+ * stopwords, construita la compilare din listele pe limbi.
+ *
+ * Utilizare: gen_stopwords NUME=fisier [NUME=fisier ...] > stopwords_table.h
+ * Fiecare limba primeste un bit (STOPWORDS_<NUME>), in ordinea argumentelor.
+ * Cuvintele sunt litere mici, UTF-8; variantele cu sedila (ş, ţ) sunt
+ * normalizate la cele cu virgula (ș, ț). */
+
+#define MAX_WORDS 4096
+#define MAX_WORD_LENGTH 63
+#define MAX_LANGUAGES 8
+#define MAX_DISPLACEMENT (1u << 24)
+
+typedef struct {
+    char word[MAX_WORD_LENGTH + 1];
+    int length;
+    int languages;
+    unsigned int hash;
+    int bucket;
+} Word;
+
+static Word words[MAX_WORDS];
+static int word_count = 0;
+
+// lowercase ASCII, ş/Ş -> ș, ţ/Ţ -> ț (lungimea ramane aceeasi)
+static void normalize_word(char* word, int length) {
+    unsigned char* w = (unsigned char*)word;
+    for (int i = 0; i < length; i++) {
+        if (w[i] < 0x80) {
+            w[i] = tolower(w[i]);
+        } else if (w[i] == 0xC5 && i + 1 < length &&
+                   (w[i + 1] == 0x9E || w[i + 1] == 0x9F)) {
+            w[i] = 0xC8;
+            w[i + 1] = 0x99;
+            i++;
+        } else if (w[i] == 0xC5 && i + 1 < length &&
+                   (w[i + 1] == 0xA2 || w[i + 1] == 0xA3)) {
+            w[i] = 0xC8;
+            w[i + 1] = 0x9B;
+            i++;
+        }
+    }
+}
+
+static void add_word(const char* word, int length, int language_bit) {
+    if (length <= 0 || length > MAX_WORD_LENGTH) return;
+    
+    for (int i = 0; i < word_count; i++) {
+        if (words[i].length == length && memcmp(words[i].word, word, length) == 0) {
+            words[i].languages |= language_bit;
+            return;
+        }
+    }
+    
+    if (word_count >= MAX_WORDS) {
+        fprintf(stderr, "gen_stopwords: prea multe cuvinte (maxim %d)\n", MAX_WORDS);
+        exit(1);
+    }
+    
+    memcpy(words[word_count].word, word, length);
+    words[word_count].word[length] = '\0';
+    words[word_count].length = length;
+    words[word_count].languages = language_bit;
+    words[word_count].hash = stopword_hash(word, length);
+    word_count++;
+}
+
+static void load_list(const char* path, int language_bit) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(1);
+    }
+    
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        int start = 0;
+        int end = strlen(line);
+        while (start < end && isspace((unsigned char)line[start])) start++;
+        while (end > start && isspace((unsigned char)line[end - 1])) end--;
+        
+        if (start == end || line[start] == '#') continue;
+        if (end - start > MAX_WORD_LENGTH) {
+            fprintf(stderr, "gen_stopwords: cuvant prea lung in %s: %s\n", path, line);
+            exit(1);
+        }
+        
+        normalize_word(line + start, end - start);
+        add_word(line + start, end - start, language_bit);
+    }
+    
+    fclose(f);
+}
+
+static int next_power_of_two(int n) {
+    int p = 1;
+    while (p < n) p *= 2;
+    return p;
+}
+
+// incearca sa plaseze toate cuvintele in slot_count sloturi
+static int build_table(int bucket_count, int slot_count, unsigned int* displacements, int* slots) {
+    int* order = malloc(bucket_count * sizeof(int));
+    int* sizes = calloc(bucket_count, sizeof(int));
+    int* placed = malloc(word_count * sizeof(int));
+    if (!order || !sizes || !placed) {
+        perror("gen_stopwords");
+        exit(1);
+    }
+    
+    for (int i = 0; i < word_count; i++) {
+        words[i].bucket = words[i].hash & (bucket_count - 1);
+        sizes[words[i].bucket]++;
+    }
+    for (int i = 0; i < slot_count; i++) {
+        slots[i] = -1;
+    }
+    
+    // bucket-urile mari primele, cand tabela e inca goala
+    for (int i = 0; i < bucket_count; i++) {
+        order[i] = i;
+    }
+    for (int i = 0; i < bucket_count - 1; i++) {
+        for (int j = i + 1; j < bucket_count; j++) {
+            if (sizes[order[j]] > sizes[order[i]]) {
+                int tmp = order[i];
+                order[i] = order[j];
+                order[j] = tmp;
+            }
+        }
+    }
+    
+    int ok = 1;
+    for (int b = 0; b < bucket_count && ok; b++) {
+        int bucket = order[b];
+        displacements[bucket] = 0;
+        if (sizes[bucket] == 0) continue;
+        
+        unsigned int d;
+        for (d = 1; d < MAX_DISPLACEMENT; d++) {
+            int count = 0;
+            int fits = 1;
+            for (int i = 0; i < word_count && fits; i++) {
+                if (words[i].bucket != bucket) continue;
+                int slot = stopword_slot(words[i].hash, d, slot_count - 1);
+                if (slots[slot] >= 0) {
+                    fits = 0;
+                    break;
+                }
+                for (int k = 0; k < count; k++) {
+                    if (placed[k] == slot) {
+                        fits = 0;
+                        break;
+                    }
+                }
+                placed[count++] = slot;
+            }
+            if (fits) break;
+        }
+        
+        if (d == MAX_DISPLACEMENT) {
+            ok = 0;
+            break;
+        }
+        
+        displacements[bucket] = d;
+        for (int i = 0; i < word_count; i++) {
+            if (words[i].bucket == bucket) {
+                slots[stopword_slot(words[i].hash, d, slot_count - 1)] = i;
+            }
+        }
+    }
+    
+    free(order);
+    free(sizes);
+    free(placed);
+    return ok;
+}
+
+static void print_escaped(const char* word) {
+    putchar('"');
+    for (const unsigned char* p = (const unsigned char*)word; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            printf("\\%c", *p);
+        } else if (*p < 0x20 || *p >= 0x7F) {
+            printf("\\%03o", *p);
+        } else {
+            putchar(*p);
+        }
+    }
+    putchar('"');
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc - 1 > MAX_LANGUAGES) {
+        fprintf(stderr, "Utilizare: gen_stopwords NUME=fisier [NUME=fisier ...]\n");
+        return 1;
+    }
+    
+    char names[MAX_LANGUAGES][32];
+    for (int i = 1; i < argc; i++) {
+        char* eq = strchr(argv[i], '=');
+        if (!eq || eq == argv[i] || eq - argv[i] >= (int)sizeof(names[0])) {
+            fprintf(stderr, "gen_stopwords: argument invalid: %s\n", argv[i]);
+            return 1;
+        }
+        memcpy(names[i - 1], argv[i], eq - argv[i]);
+        names[i - 1][eq - argv[i]] = '\0';
+        load_list(eq + 1, 1 << (i - 1));
+    }
+    
+    int bucket_count = next_power_of_two((word_count + 3) / 4);
+    int slot_count = next_power_of_two(word_count * 2);
+    unsigned int* displacements = malloc(bucket_count * sizeof(unsigned int));
+    int* slots = malloc(slot_count * 4 * sizeof(int));
+    if (!displacements || !slots) {
+        perror("gen_stopwords");
+        return 1;
+    }
+    
+    while (!build_table(bucket_count, slot_count, displacements, slots)) {
+        if (slot_count >= word_count * 8) {
+            fprintf(stderr, "gen_stopwords: nu s-a gasit un hash perfect\n");
+            return 1;
+        }
+        slot_count *= 2;
+    }
+    
+    int max_length = 0;
+    for (int i = 0; i < word_count; i++) {
+        if (words[i].length > max_length) max_length = words[i].length;
+    }
+    
+    printf("/* Generat de tools/gen_stopwords - nu editati manual. */\n");
+    printf("#ifndef STOPWORDS_TABLE_H\n#define STOPWORDS_TABLE_H\n\n");
+    printf("#include \"stopword_hash.h\"\n\n");
+    for (int i = 0; i < argc - 1; i++) {
+        printf("#define STOPWORDS_%s 0x%x\n", names[i], 1 << i);
+    }
+    printf("#define STOPWORDS_ALL 0x%x\n\n", (1 << (argc - 1)) - 1);
+    printf("#define STOPWORD_COUNT %d\n", word_count);
+    printf("#define STOPWORD_MAX_LENGTH %d\n", max_length);
+    printf("#define STOPWORD_BUCKETS %d\n", bucket_count);
+    printf("#define STOPWORD_SLOTS %d\n\n", slot_count);
+    
+    printf("static const unsigned int stopword_displacements[STOPWORD_BUCKETS] = {");
+    for (int i = 0; i < bucket_count; i++) {
+        printf("%s%u", (i % 8 == 0) ? "\n    " : " ", displacements[i]);
+        if (i < bucket_count - 1) putchar(',');
+    }
+    printf("\n};\n\n");
+    
+    printf("static const StopwordEntry stopword_table[STOPWORD_SLOTS] = {\n");
+    for (int i = 0; i < slot_count; i++) {
+        if (slots[i] < 0) continue;
+        Word* w = &words[slots[i]];
+        printf("    [%d] = {", i);
+        print_escaped(w->word);
+        printf(", %d, 0x%x},\n", w->length, w->languages);
+    }
+    printf("};\n\n#endif\n");
+    
+    free(displacements);
+    free(slots);
+    return 0;
+}
@@ -0,0 +1,740 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../common/nlp.h"
+#include "../common/model_snapshot.h"
+
+/* Antrenare offline a clasificatorului Bayes din documente etichetate.
+ *
+ * Intrarile sunt directoare (DIR/<Domeniu>/<fisier>: fiecare fisier e un
+ * document al domeniului dat de subdirector) sau fisiere JSONL (cate un
+ * obiect pe linie, {"domain": "Sport", "text": "..."}; "label" e acceptat
+ * in loc de "domain"). Fisierele JSONL sunt mapate si impartite in bucati
+ * la granita de linie.
+ *
+ * Map: fiecare thread ia documente sau bucati din lista comuna si le
+ * tokenizeaza intr-un tabel partial propriu (un BayesClassifier, fara
+ * niciun lock). Reduce: tabelele se imbina doua cate doua, in paralel,
+ * in log2(thread-uri) runde. Rezultatul e un snapshot pe care serverul il
+ * incarca cu --model. */
+
+#define MAX_THREADS 256
+#define JSONL_CHUNK_SIZE (4 * 1024 * 1024)
+#define ARENA_BLOCK_SIZE (256 * 1024)
+#define INITIAL_JOB_CAPACITY 1024
+
+typedef enum {
+    JOB_FILE,       // un document intr-un fisier
+    JOB_JSONL       // o bucata de linii JSONL
+} JobType;
+
+typedef struct {
+    JobType type;
+    char* path;             // JOB_FILE
+    const char* domain;     // JOB_FILE, numele subdirectorului
+    const char* data;       // JOB_JSONL, in maparea fisierului
+    size_t length;
+    int input;              // indexul intrarii, pentru mesaje
+    // rezultate, pentru JOB_JSONL
+    long lines;
+    long invalid;
+    long first_invalid;     // linia in bucata (de la 1), 0 = niciuna
+} TrainingJob;
+
+typedef struct {
+    const char* path;
+    void* mapping;          // fisierele JSONL
+    size_t size;
+} TrainingInput;
+
+typedef struct {
+    BayesClassifier* table;     // tabelul partial al thread-ului
+    Arena* arena;
+    char* buffer;               // continutul unui fisier / textul decodat
+    size_t buffer_capacity;
+    long documents;
+    size_t bytes;
+    int failed;
+} Worker;
+
+typedef struct {
+    int threads;
+    int strip_diacritics;
+    const char* output;
+} TrainerConfig;
+
+static TrainerConfig config = { 0, 0, NULL };
+
+static TrainingInput* inputs;
+static int input_count;
+
+static TrainingJob* jobs;
+static int job_count;
+static int job_capacity;
+static atomic_int next_job;
+static char** domain_names;     // numele subdirectoarelor, eliberate la final
+static int domain_name_count;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static TrainingJob* add_job(JobType type, int input) {
+    if (job_count == job_capacity) {
+        int capacity = job_capacity ? job_capacity * 2 : INITIAL_JOB_CAPACITY;
+        TrainingJob* grown = (TrainingJob*)realloc(jobs, capacity * sizeof(TrainingJob));
+        if (!grown) return NULL;
+        jobs = grown;
+        job_capacity = capacity;
+    }
+    TrainingJob* job = &jobs[job_count++];
+    memset(job, 0, sizeof(TrainingJob));
+    job->type = type;
+    job->input = input;
+    return job;
+}
+
+static int ensure_buffer(Worker* worker, size_t size) {
+    if (size <= worker->buffer_capacity) {
+        return 0;
+    }
+    size_t capacity = worker->buffer_capacity ? worker->buffer_capacity : 65536;
+    while (capacity < size) {
+        capacity *= 2;
+    }
+    char* grown = (char*)realloc(worker->buffer, capacity);
+    if (!grown) return -1;
+    worker->buffer = grown;
+    worker->buffer_capacity = capacity;
+    return 0;
+}
+
+// Tokenizeaza documentul si il adauga in tabelul thread-ului
+static void train_document(Worker* worker, const char* text, size_t length, const char* domain) {
+    if (add_bayes_domain(worker->table, domain) < 0) {
+        worker->failed = 1;
+        return;
+    }
+    TokenizationResult* tokens = tokenize_text_arena(text, worker->arena);
+    if (!tokens) {
+        worker->failed = 1;
+        return;
+    }
+    train_bayes_classifier_tokens(worker->table, tokens, domain);
+    arena_reset(worker->arena);
+    worker->documents++;
+    worker->bytes += length;
+}
+
+
+// --- JSON ---
+
+static const char* skip_space(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+        p++;
+    }
+    return p;
+}
+
+static int hex_value(const char* p, const char* end) {
+    if (end - p < 4) return -1;
+    int value = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = p[i];
+        int digit = c >= '0' && c <= '9' ? c - '0' :
+                    c >= 'a' && c <= 'f' ? c - 'a' + 10 :
+                    c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+        if (digit < 0) return -1;
+        value = value << 4 | digit;
+    }
+    return value;
+}
+
+static char* put_utf8(char* out, unsigned int code) {
+    if (code < 0x80) {
+        *out++ = (char)code;
+    } else if (code < 0x800) {
+        *out++ = (char)(0xC0 | code >> 6);
+        *out++ = (char)(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        *out++ = (char)(0xE0 | code >> 12);
+        *out++ = (char)(0x80 | (code >> 6 & 0x3F));
+        *out++ = (char)(0x80 | (code & 0x3F));
+    } else {
+        *out++ = (char)(0xF0 | code >> 18);
+        *out++ = (char)(0x80 | (code >> 12 & 0x3F));
+        *out++ = (char)(0x80 | (code >> 6 & 0x3F));
+        *out++ = (char)(0x80 | (code & 0x3F));
+    }
+    return out;
+}
+
+// Sirul care incepe la p (dupa ghilimele), decodat in out daca out nu e
+// NULL (decodat nu e niciodata mai lung decat in sursa). Intoarce pozitia
+// de dupa ghilimelele de inchidere sau NULL daca sirul e invalid.
+static const char* parse_string(const char* p, const char* end, char* out, size_t* out_length) {
+    char* start = out;
+    while (p < end && *p != '"') {
+        if (*p != '\\') {
+            if (out) *out++ = *p;
+            p++;
+            continue;
+        }
+        if (++p == end) return NULL;
+        char escape = *p++;
+        unsigned int code;
+        switch (escape) {
+            case '"': case '\\': case '/': code = escape; break;
+            case 'b': code = '\b'; break;
+            case 'f': code = '\f'; break;
+            case 'n': code = '\n'; break;
+            case 'r': code = '\r'; break;
+            case 't': code = '\t'; break;
+            case 'u': {
+                int value = hex_value(p, end);
+                if (value < 0) return NULL;
+                p += 4;
+                code = value;
+                // perechi surogat -> un singur caracter
+                if (code >= 0xD800 && code <= 0xDBFF) {
+                    int low = end - p >= 2 && p[0] == '\\' && p[1] == 'u' ? hex_value(p + 2, end) : -1;
+                    if (low < 0xDC00 || low > 0xDFFF) return NULL;
+                    p += 6;
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                    return NULL;
+                }
+                // '\0' ar termina textul inainte de vreme
+                if (code == 0) code = ' ';
+                break;
+            }
+            default:
+                return NULL;
+        }
+        if (out) out = put_utf8(out, code);
+    }
+    if (p == end) return NULL;
+    if (out) {
+        *out = '\0';
+        *out_length = out - start;
+    }
+    return p + 1;
+}
+
+// Sare peste o valoare de orice tip; NULL daca e invalida
+static const char* skip_value(const char* p, const char* end) {
+    if (p == end) return NULL;
+    if (*p == '"') {
+        return parse_string(p + 1, end, NULL, NULL);
+    }
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (p < end) {
+            if (*p == '"') {
+                p = parse_string(p + 1, end, NULL, NULL);
+                if (!p) return NULL;
+                continue;
+            }
+            if (*p == '{' || *p == '[') {
+                depth++;
+            } else if (*p == '}' || *p == ']') {
+                if (--depth == 0) return p + 1;
+            }
+            p++;
+        }
+        return NULL;
+    }
+    // numar, true, false, null
+    const char* start = p;
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\r') {
+        p++;
+    }
+    return p > start ? p : NULL;
+}
+
+static int key_is(const char* key, size_t length, const char* name) {
+    return length == strlen(name) && memcmp(key, name, length) == 0;
+}
+
+// Un obiect JSONL: textul si domeniul, decodate in buffer-ul worker-ului.
+// -1 daca linia nu e un obiect valid sau ii lipseste unul din campuri.
+static int parse_document(Worker* worker, const char* line, size_t length,
+                          const char** text, size_t* text_length, const char** domain) {
+    if (ensure_buffer(worker, 2 * (length + 1)) < 0) {
+        worker->failed = 1;
+        return -1;
+    }
+    char* text_out = worker->buffer;
+    char* domain_out = worker->buffer + length + 1;
+    *text = NULL;
+    *domain = NULL;
+    
+    const char* end = line + length;
+    const char* p = skip_space(line, end);
+    if (p == end || *p != '{') return -1;
+    p = skip_space(p + 1, end);
+    
+    while (p < end && *p != '}') {
+        if (*p != '"') return -1;
+        const char* key = p + 1;
+        p = parse_string(key, end, NULL, NULL);
+        if (!p) return -1;
+        size_t key_length = p - 1 - key;
+    
+        p = skip_space(p, end);
+        if (p == end || *p != ':') return -1;
+        p = skip_space(p + 1, end);
+    
+        size_t value_length;
+        if (key_is(key, key_length, "text") && p < end && *p == '"') {
+            p = parse_string(p + 1, end, text_out, &value_length);
+            *text = text_out;
+            *text_length = value_length;
+        } else if ((key_is(key, key_length, "domain") || key_is(key, key_length, "label")) &&
+                   p < end && *p == '"') {
+            p = parse_string(p + 1, end, domain_out, &value_length);
+            *domain = value_length > 0 ? domain_out : NULL;
+        } else {
+            p = skip_value(p, end);
+        }
+        if (!p) return -1;
+    
+        p = skip_space(p, end);
+        if (p < end && *p == ',') {
+            p = skip_space(p + 1, end);
+        } else if (p == end || *p != '}') {
+            return -1;
+        }
+    }
+    if (p == end) return -1;
+    
+    return *text && *domain ? 0 : -1;
+}
+
+static void process_jsonl(Worker* worker, TrainingJob* job) {
+    const char* p = job->data;
+    const char* end = job->data + job->length;
+    
+    while (p < end) {
+        const char* newline = memchr(p, '\n', end - p);
+        const char* line_end = newline ? newline : end;
+        job->lines++;
+    
+        if (skip_space(p, line_end) < line_end) {
+            const char *text, *domain;
+            size_t text_length;
+            if (parse_document(worker, p, line_end - p, &text, &text_length, &domain) == 0) {
+                train_document(worker, text, text_length, domain);
+            } else {
+                job->invalid++;
+                if (!job->first_invalid) {
+                    job->first_invalid = job->lines;
+                }
+            }
+        }
+        p = line_end + 1;
+    }
+}
+
+
+// --- Fisiere ---
+
+static void process_file(Worker* worker, TrainingJob* job) {
+    int fd = open(job->path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        perror(job->path);
+        if (fd >= 0) close(fd);
+        return;
+    }
+    if (ensure_buffer(worker, (size_t)st.st_size + 1) < 0) {
+        worker->failed = 1;
+        close(fd);
+        return;
+    }
+    
+    size_t length = 0;
+    while (length < (size_t)st.st_size) {
+        ssize_t n = read(fd, worker->buffer + length, st.st_size - length);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        length += n;
+    }
+    close(fd);
+    worker->buffer[length] = '\0';
+    
+    train_document(worker, worker->buffer, length, job->domain);
+}
+
+static void* worker_thread(void* arg) {
+    Worker* worker = (Worker*)arg;
+    
+    while (!worker->failed) {
+        int index = atomic_fetch_add(&next_job, 1);
+        if (index >= job_count) {
+            break;
+        }
+        if (jobs[index].type == JOB_JSONL) {
+            process_jsonl(worker, &jobs[index]);
+        } else {
+            process_file(worker, &jobs[index]);
+        }
+    }
+    return NULL;
+}
+
+
+// --- Intrari ---
+
+// DIR/<Domeniu>/<fisier>; fisierele si directoarele ascunse sunt ignorate
+static int add_directory(const char* path, int input) {
+    DIR* dir = opendir(path);
+    if (!dir) {
+        perror(path);
+        return -1;
+    }
+    
+    struct dirent* entry;
+    while ((entry = readdir(dir))) {
+        if (entry->d_name[0] == '.') continue;
+    
+        char domain_path[4096];
+        struct stat st;
+        snprintf(domain_path, sizeof(domain_path), "%s/%s", path, entry->d_name);
+        if (stat(domain_path, &st) < 0 || !S_ISDIR(st.st_mode)) continue;
+    
+        DIR* domain_dir = opendir(domain_path);
+        if (!domain_dir) {
+            perror(domain_path);
+            continue;
+        }
+        char** names = (char**)realloc(domain_names, (domain_name_count + 1) * sizeof(char*));
+        if (!names) {
+            closedir(domain_dir);
+            closedir(dir);
+            return -1;
+        }
+        domain_names = names;
+        char* domain = strdup(entry->d_name);
+        if (!domain) {
+            closedir(domain_dir);
+            closedir(dir);
+            return -1;
+        }
+        domain_names[domain_name_count++] = domain;
+    
+        struct dirent* file;
+        while ((file = readdir(domain_dir))) {
+            if (file->d_name[0] == '.') continue;
+    
+            char file_path[sizeof(domain_path) + 256];
+            snprintf(file_path, sizeof(file_path), "%s/%s", domain_path, file->d_name);
+            if (stat(file_path, &st) < 0 || !S_ISREG(st.st_mode)) continue;
+    
+            TrainingJob* job = add_job(JOB_FILE, input);
+            if (!job || !(job->path = strdup(file_path))) {
+                closedir(domain_dir);
+                closedir(dir);
+                return -1;
+            }
+            job->domain = domain;
+        }
+        closedir(domain_dir);
+    }
+    closedir(dir);
+    return 0;
+}
+
+// Bucati de cel mult JSONL_CHUNK_SIZE, terminate la sfarsit de linie
+static int add_jsonl(TrainingInput* source, int input) {
+    int fd = open(source->path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        perror(source->path);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    source->size = st.st_size;
+    if (source->size == 0) {
+        close(fd);
+        return 0;
+    }
+    
+    source->mapping = mmap(NULL, source->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (source->mapping == MAP_FAILED) {
+        source->mapping = NULL;
+        perror(source->path);
+        return -1;
+    }
+    madvise(source->mapping, source->size, MADV_SEQUENTIAL);
+    
+    const char* data = (const char*)source->mapping;
+    size_t offset = 0;
+    while (offset < source->size) {
+        size_t chunk_end = offset + JSONL_CHUNK_SIZE;
+        if (chunk_end >= source->size) {
+            chunk_end = source->size;
+        } else {
+            const char* newline = memchr(data + chunk_end, '\n', source->size - chunk_end);
+            chunk_end = newline ? (size_t)(newline - data) + 1 : source->size;
+        }
+    
+        TrainingJob* job = add_job(JOB_JSONL, input);
+        if (!job) return -1;
+        job->data = data + offset;
+        job->length = chunk_end - offset;
+        offset = chunk_end;
+    }
+    return 0;
+}
+
+static int add_input(int input) {
+    struct stat st;
+    if (stat(inputs[input].path, &st) < 0) {
+        perror(inputs[input].path);
+        return -1;
+    }
+    return S_ISDIR(st.st_mode) ? add_directory(inputs[input].path, input) : add_jsonl(&inputs[input], input);
+}
+
+// Liniile invalide, pe fisiere (bucatile unui fisier sunt consecutive)
+static long report_invalid_lines(void) {
+    long total = 0;
+    int j = 0;
+    while (j < job_count) {
+        if (jobs[j].type != JOB_JSONL) {
+            j++;
+            continue;
+        }
+        int input = jobs[j].input;
+        long lines_before = 0, invalid = 0, first = 0;
+        for (; j < job_count && jobs[j].type == JOB_JSONL && jobs[j].input == input; j++) {
+            if (jobs[j].first_invalid && !first) {
+                first = lines_before + jobs[j].first_invalid;
+            }
+            invalid += jobs[j].invalid;
+            lines_before += jobs[j].lines;
+        }
+        if (invalid > 0) {
+            fprintf(stderr, "%s:%ld: %ld linii ignorate (obiect JSON invalid sau fără \"text\"/\"domain\")\n",
+                    inputs[input].path, first, invalid);
+        }
+        total += invalid;
+    }
+    return total;
+}
+
+
+// --- Reduce ---
+
+typedef struct {
+    BayesClassifier* into;
+    BayesClassifier* from;
+    int failed;
+} MergePair;
+
+static void* merge_thread(void* arg) {
+    MergePair* pair = (MergePair*)arg;
+    pair->failed = merge_bayes_classifier(pair->into, pair->from) < 0;
+    free_bayes_classifier(pair->from);
+    return NULL;
+}
+
+// Imbina tabelele doua cate doua, in paralel; rezultatul ramane in tables[0]
+static int merge_tables(BayesClassifier** tables, int count) {
+    MergePair pairs[MAX_THREADS / 2];
+    pthread_t tids[MAX_THREADS / 2];
+    int failed = 0;
+    
+    for (int stride = 1; stride < count; stride *= 2) {
+        int pair_count = 0;
+        for (int i = 0; i + stride < count; i += 2 * stride) {
+            pairs[pair_count].into = tables[i];
+            pairs[pair_count].from = tables[i + stride];
+            tables[i + stride] = NULL;
+            if (pthread_create(&tids[pair_count], NULL, merge_thread, &pairs[pair_count]) != 0) {
+                merge_thread(&pairs[pair_count]);
+                tids[pair_count] = 0;
+            }
+            pair_count++;
+        }
+        for (int i = 0; i < pair_count; i++) {
+            if (tids[i]) {
+                pthread_join(tids[i], NULL);
+            }
+            failed |= pairs[i].failed;
+        }
+    }
+    return failed ? -1 : 0;
+}
+
+
+void print_usage() {
+    printf("Utilizare: trainer_bin [OPTIUNI] --output MODEL INTRARE...\n");
+    printf("Intrări:\n");
+    printf("  DIRECTOR                 - DIRECTOR/<Domeniu>/<fișier>, câte un document pe fișier\n");
+    printf("  FIȘIER.jsonl             - câte un obiect pe linie: {\"domain\": \"Sport\", \"text\": \"...\"}\n");
+    printf("                             (\"label\" e acceptat în loc de \"domain\")\n");
+    printf("Optiuni:\n");
+    printf("  --output FIȘIER          - Modelul scris, încărcat de server cu --model\n");
+    printf("  --threads N              - Thread-uri de tokenizare (implicit: câte unul pe nucleu)\n");
+    printf("  --diacritics MOD         - keep (implicit) sau strip; trebuie să fie același ca la server\n");
+}
+
+static int parse_arguments(int argc, char* argv[]) {
+    inputs = (TrainingInput*)calloc(argc, sizeof(TrainingInput));
+    if (!inputs) return -1;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--", 2) != 0) {
+            inputs[input_count++].path = argv[i];
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return -1;
+        }
+    
+        const char* value = argv[++i];
+        if (strcmp(argv[i - 1], "--output") == 0) {
+            config.output = value;
+        } else if (strcmp(argv[i - 1], "--threads") == 0) {
+            config.threads = atoi(value);
+            if (config.threads <= 0 || config.threads > MAX_THREADS) {
+                return -1;
+            }
+        } else if (strcmp(argv[i - 1], "--diacritics") == 0) {
+            if (strcmp(value, "keep") == 0) {
+                config.strip_diacritics = 0;
+            } else if (strcmp(value, "strip") == 0) {
+                config.strip_diacritics = 1;
+            } else {
+                return -1;
+            }
+        } else {
+            return -1;
+        }
+    }
+    return config.output && input_count > 0 ? 0 : -1;
+}
+
+int main(int argc, char* argv[]) {
+    if (parse_arguments(argc, argv) < 0) {
+        print_usage();
+        return 1;
+    }
+    if (config.threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        config.threads = cpus <= 0 ? 1 : cpus > MAX_THREADS ? MAX_THREADS : (int)cpus;
+    }
+    
+    // inainte de orice tokenizare, ca la server
+    set_strip_diacritics(config.strip_diacritics);
+    
+    for (int i = 0; i < input_count; i++) {
+        if (add_input(i) < 0) {
+            return 1;
+        }
+    }
+    
+    // map: fiecare thread cu tabelul lui
+    double start = now_seconds();
+    Worker* workers = (Worker*)calloc(config.threads, sizeof(Worker));
+    pthread_t* tids = (pthread_t*)calloc(config.threads, sizeof(pthread_t));
+    if (!workers || !tids) {
+        perror("Eroare la alocarea memoriei");
+        return 1;
+    }
+    atomic_init(&next_job, 0);
+    for (int i = 0; i < config.threads; i++) {
+        workers[i].table = create_bayes_classifier();
+        workers[i].arena = arena_create(ARENA_BLOCK_SIZE);
+        if (!workers[i].table || !workers[i].arena) {
+            perror("Eroare la alocarea memoriei");
+            return 1;
+        }
+        if (pthread_create(&tids[i], NULL, worker_thread, &workers[i]) != 0) {
+            perror("Eroare la crearea thread-ului de antrenare");
+            return 1;
+        }
+    }
+    
+    long documents = 0;
+    size_t bytes = 0;
+    int failed = 0;
+    BayesClassifier* tables[MAX_THREADS];
+    for (int i = 0; i < config.threads; i++) {
+        pthread_join(tids[i], NULL);
+        documents += workers[i].documents;
+        bytes += workers[i].bytes;
+        failed |= workers[i].failed;
+        tables[i] = workers[i].table;
+        arena_destroy(workers[i].arena);
+        free(workers[i].buffer);
+    }
+    double map_seconds = now_seconds() - start;
+    if (failed) {
+        fprintf(stderr, "Eroare la alocarea memoriei\n");
+        return 1;
+    }
+    long invalid = report_invalid_lines();
+    
+    // reduce
+    start = now_seconds();
+    if (merge_tables(tables, config.threads) < 0) {
+        fprintf(stderr, "Eroare la alocarea memoriei\n");
+        return 1;
+    }
+    double merge_seconds = now_seconds() - start;
+    
+    BayesClassifier* model = tables[0];
+    if (model->total_documents == 0) {
+        fprintf(stderr, "Niciun document de antrenare\n");
+        return 1;
+    }
+    
+    printf("Documente: %ld (%.1f MB), ignorate: %ld\n", documents, bytes / 1e6, invalid);
+    for (int d = 0; d < model->count; d++) {
+        printf("  %-20s %d\n", model->domains[d].domain, model->domains[d].document_count);
+    }
+    printf("Vocabular: %d cuvinte\n", model->vocabulary.count);
+    printf("Tokenizare: %.2f s pe %d thread-uri (%.0f documente/s, %.1f MB/s), îmbinare: %.2f s\n",
+           map_seconds, config.threads, documents / map_seconds, bytes / 1e6 / map_seconds, merge_seconds);
+    
+    long long size = save_model_snapshot(model, config.strip_diacritics, config.output);
+    if (size < 0) {
+        perror(config.output);
+        return 1;
+    }
+    printf("Model scris în %s: %lld bytes\n", config.output, size);
+    
+    free_bayes_classifier(model);
+    for (int j = 0; j < job_count; j++) {
+        free(jobs[j].path);
+    }
+    free(jobs);
+    for (int i = 0; i < domain_name_count; i++) {
+        free(domain_names[i]);
+    }
+    free(domain_names);
+    for (int i = 0; i < input_count; i++) {
+        if (inputs[i].mapping) {
+            munmap(inputs[i].mapping, inputs[i].size);
+        }
+    }
+    free(inputs);
+    free(workers);
+    free(tids);
+    return 0;
+}